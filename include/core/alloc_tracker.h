@@ -0,0 +1,62 @@
+/**
+ * @file alloc_tracker.h
+ * @brief Defines a heap allocation counter hooked into SDL's allocator.
+ *
+ * Once installed, every SDL_malloc(), SDL_calloc() and SDL_realloc() is
+ * counted, together with the bytes it asked for, before being passed on to
+ * the allocator SDL used before. That covers SDL itself, SDL_ttf, SDL_mixer
+ * and SDL_image, and the game's own allocations, which all go through
+ * SDL_malloc() for this reason. Allocations made by drivers and the C
+ * library directly are not seen.
+ *
+ * The counters are shared by every thread and only ever grow, so the
+ * allocations made during a span of code are the difference between two
+ * readings. Counting costs two atomic adds per allocation; nothing is
+ * counted until alloc_tracker_install() is called.
+ */
+
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include "utils/types.h"
+
+/**
+ * @struct AllocCounts
+ * @brief A number of allocations and the bytes they requested.
+ *
+ * Running totals wrap around; only differences between them are meaningful.
+ */
+typedef struct {
+  Uint32 count;  ///< Allocations, including reallocations.
+  Uint32 bytes;  ///< Bytes requested by them.
+} AllocCounts;
+
+// --- Public API ---
+
+/**
+ * @brief Starts counting allocations. Must be called before anything is
+ * allocated through SDL, and at most once.
+ * @return true on success, false if SDL rejected the hooks.
+ */
+bool alloc_tracker_install(void);
+
+/**
+ * @brief Checks whether allocations are being counted.
+ * @return true once alloc_tracker_install() succeeded.
+ */
+bool alloc_tracker_installed(void);
+
+/**
+ * @brief Reads the running totals.
+ * @return The allocations counted since the tracker was installed.
+ */
+AllocCounts alloc_tracker_totals(void);
+
+/**
+ * @brief Computes the allocations made since an earlier reading.
+ * @param start The totals read at the start of the span.
+ * @return The allocations made since then.
+ */
+AllocCounts alloc_tracker_since(AllocCounts start);
+
+#endif  // ALLOC_TRACKER_H
@@ -0,0 +1,66 @@
+/**
+ * @file arena.h
+ * @brief Defines a linear (bump) memory arena.
+ *
+ * An arena owns one aligned block of memory and hands out sub-allocations by
+ * advancing an offset. Individual allocations are never freed; the whole
+ * arena is released or reset at once.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "utils/types.h"
+
+/// Default alignment of arena allocations, one cache line.
+#define ARENA_DEFAULT_ALIGNMENT 64
+
+/**
+ * @struct Arena
+ * @brief A linear allocator over a single heap block.
+ *
+ * A zero-initialized Arena is a valid "measuring" arena: allocations from it
+ * return NULL but still advance `used`, so a layout function can be run once
+ * to compute the exact size needed and again on a real arena to carve it up.
+ */
+typedef struct {
+  Uint8* base;      ///< The aligned start of the block, or NULL if measuring.
+  void* raw;        ///< The pointer returned by the allocator, for freeing.
+  size_t capacity;  ///< The usable size of the block in bytes.
+  size_t used;      ///< The number of bytes handed out so far.
+} Arena;
+
+// --- Public API ---
+
+/**
+ * @brief Allocates the backing block of an arena.
+ * @param arena A pointer to the Arena to initialize.
+ * @param capacity The number of bytes the arena can hand out.
+ * @return true on success, false if the allocation failed.
+ */
+bool arena_init(Arena* arena, size_t capacity);
+
+/**
+ * @brief Frees the backing block of an arena and zeroes it.
+ * @param arena A pointer to the Arena to destroy.
+ */
+void arena_destroy(Arena* arena);
+
+/**
+ * @brief Hands out an aligned, uninitialized sub-allocation.
+ * @param arena A pointer to the Arena.
+ * @param size The number of bytes requested.
+ * @param alignment The required alignment, a power of two no larger than
+ * ARENA_DEFAULT_ALIGNMENT.
+ * @return A pointer to the memory, or NULL if the arena is measuring or
+ * out of space.
+ */
+void* arena_alloc(Arena* arena, size_t size, size_t alignment);
+
+/**
+ * @brief Makes the whole arena available again without freeing it.
+ * @param arena A pointer to the Arena to reset.
+ */
+void arena_reset(Arena* arena);
+
+#endif  // ARENA_H
@@ -0,0 +1,122 @@
+/**
+ * @file asset_loader.h
+ * @brief Defines the background thread that loads the game's assets.
+ *
+ * Reading and decoding assets (rendering the glyph atlases, decoding the
+ * background image, converting the sound effects, opening the music) runs on
+ * a loader thread while the main loop already presents frames. The loader
+ * works through a fixed list of jobs, fonts first, and publishes each result
+ * in order through a completion queue. Once per frame the main thread
+ * installs whatever has completed, which for images means creating their
+ * textures; that is the only part that has to run on the render thread.
+ *
+ * While loading, nothing else may use SDL_ttf or reopen the audio device.
+ */
+
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include "core/asset_pack.h"
+#include "utils/types.h"
+
+/**
+ * @enum AssetJob
+ * @brief The loader's jobs, in the order it runs them.
+ */
+typedef enum {
+  ASSET_JOB_FONT_NORMAL,  ///< The normal font and its glyph atlas.
+  ASSET_JOB_FONT_LARGE,   ///< The large font and its glyph atlas.
+  ASSET_JOB_FONT_SMALL,   ///< The small font and its glyph atlas.
+  ASSET_JOB_BACKGROUND,   ///< The decoded background image.
+  ASSET_JOB_SOUNDS,       ///< Every sound effect.
+  ASSET_JOB_MUSIC,        ///< The background music.
+  ASSET_JOB_COUNT         ///< Number of jobs.
+} AssetJob;
+
+/// Jobs that must be installed before the menu can be shown.
+#define ASSET_JOB_FONTS (ASSET_JOB_FONT_SMALL + 1)
+
+/**
+ * @struct AssetLoadResult
+ * @brief What one job produced. Only the fields of its kind are set.
+ */
+typedef struct {
+  TTF_Font* font;       ///< The opened font.
+  GlyphAtlas atlas;     ///< The font's atlas, without its texture yet.
+  SDL_Surface* pixels;  ///< The glyph sheet, or the decoded background.
+  Mix_Chunk* sounds[SOUND_COUNT];  ///< Sound effects, indexed by SoundId.
+  Mix_Music* music;                ///< The background music.
+  bool failed;                     ///< True if a required asset is missing.
+} AssetLoadResult;
+
+/**
+ * @struct AssetLoader
+ * @brief The loader thread and its completion queue.
+ *
+ * A result belongs to the loader until `completed` covers it, and to the
+ * main thread afterwards. SDL_AtomicSet() is a full barrier, so a result is
+ * visible before the count that publishes it.
+ */
+typedef struct {
+  const AssetPack* pack;  ///< The archive to load from, which may be empty.
+  SDL_Thread* thread;     ///< The loader thread, or NULL once joined.
+  AssetLoadResult results[ASSET_JOB_COUNT];  ///< One per job.
+  SDL_atomic_t completed;  ///< Jobs published by the loader, in order.
+  SDL_atomic_t cancel;     ///< Set to make the loader stop early.
+  int installed;           ///< Jobs installed by the main thread.
+} AssetLoader;
+
+// --- Public API ---
+
+/**
+ * @brief Starts loading every asset on a new thread.
+ * @param loader A pointer to the AssetLoader to start.
+ * @param pack A constant pointer to the asset archive, which may be empty;
+ * it must stay open until everything loaded from it is freed.
+ * @return true if the thread started, false otherwise.
+ */
+bool asset_loader_start(AssetLoader* loader, const AssetPack* pack);
+
+/**
+ * @brief Installs the results completed since the last call into the
+ * renderer and the audio context, and starts the music once it is loaded.
+ * Render thread only.
+ * @param loader A pointer to the AssetLoader.
+ * @param renderer A pointer to the RendererContext to attach fonts and the
+ * background to.
+ * @param audio A pointer to the AudioContext to attach sounds and music to.
+ * @return false if a font failed to load, which the game cannot run
+ * without; true otherwise.
+ */
+bool asset_loader_poll(AssetLoader* loader, RendererContext* renderer,
+                       AudioContext* audio);
+
+/**
+ * @brief Checks whether every font is installed, so text can be drawn.
+ * @param loader A constant pointer to the AssetLoader.
+ * @return true once the fonts are installed.
+ */
+bool asset_loader_fonts_ready(const AssetLoader* loader);
+
+/**
+ * @brief Checks whether every job is installed.
+ * @param loader A constant pointer to the AssetLoader.
+ * @return true once loading is over.
+ */
+bool asset_loader_done(const AssetLoader* loader);
+
+/**
+ * @brief Computes the share of the jobs installed so far.
+ * @param loader A constant pointer to the AssetLoader.
+ * @return The progress, from 0.0 to 1.0.
+ */
+float asset_loader_progress(const AssetLoader* loader);
+
+/**
+ * @brief Stops the loader thread and frees every result that was not
+ * installed. Call before the renderer and audio are cleaned up.
+ * @param loader A pointer to the AssetLoader to stop.
+ */
+void asset_loader_stop(AssetLoader* loader);
+
+#endif  // ASSET_LOADER_H
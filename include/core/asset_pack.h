@@ -0,0 +1,116 @@
+/**
+ * @file asset_pack.h
+ * @brief Defines the packed asset archive and its reader and writer.
+ *
+ * The archive bundles every asset the game loads at startup into one file,
+ * already in the form the game needs: images as raw pixels in a texture
+ * format, sound effects as samples in the mixer's device format, and
+ * everything else (fonts, music) as the original file bytes. The game maps
+ * the archive into memory and builds textures, chunks and fonts straight
+ * from the mapped bytes, so startup neither decodes nor copies them.
+ *
+ * Entries are named after the loose file they were packed from, so a lookup
+ * that fails can fall back to loading that file.
+ */
+
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include "utils/constants.h"
+#include "utils/types.h"
+
+/**
+ * @enum AssetType
+ * @brief How an entry's bytes are stored.
+ */
+typedef enum {
+  ASSET_BLOB,   ///< The original file, unchanged.
+  ASSET_IMAGE,  ///< Decoded pixels; `format` is an SDL_PixelFormatEnum.
+  ASSET_SOUND   ///< Decoded samples; `format` is an SDL_AudioFormat.
+} AssetType;
+
+/**
+ * @struct AssetEntry
+ * @brief Describes one asset in the archive.
+ */
+typedef struct {
+  char name[ASSET_NAME_LENGTH];  ///< Path of the file it was packed from.
+  AssetType type;                ///< How the bytes are stored.
+  Uint32 format;  ///< Pixel or sample format; unused for blobs.
+  Uint32 width;   ///< Image width, or sound sample rate (Hz).
+  Uint32 height;  ///< Image height, or sound channels.
+  Uint32 pitch;   ///< Bytes per image row; unused otherwise.
+  Uint64 offset;  ///< Start of the bytes from the start of the archive.
+  Uint64 size;    ///< Length of the bytes.
+} AssetEntry;
+
+/**
+ * @struct AssetPack
+ * @brief An archive mapped into memory, with its table of entries.
+ */
+typedef struct {
+  const Uint8* data;  ///< The whole archive, or NULL when none is open.
+  size_t size;        ///< Length of the archive in bytes.
+  bool mapped;        ///< True if `data` is a file mapping, false if it was
+                      ///< read into memory.
+  AssetEntry entries[ASSET_PACK_MAX_ENTRIES];  ///< The table of contents.
+  int entry_count;                             ///< Entries in the table.
+} AssetPack;
+
+// --- Public API ---
+
+/**
+ * @brief Maps an archive into memory and reads its table of contents.
+ * @param pack A pointer to the AssetPack to open.
+ * @param path The archive file.
+ * @return true on success, false if the file is missing or not a valid
+ * archive; the pack is then empty, so lookups fail.
+ */
+bool asset_pack_open(AssetPack* pack, const char* path);
+
+/**
+ * @brief Unmaps an archive. Nothing created from its bytes may be used
+ * afterwards.
+ * @param pack A pointer to the AssetPack to close.
+ */
+void asset_pack_close(AssetPack* pack);
+
+/**
+ * @brief Looks up an entry by name and type.
+ * @param pack A constant pointer to the AssetPack, which may be empty.
+ * @param name The path the asset was packed from.
+ * @param type The type the entry must have.
+ * @return A constant pointer to the entry, or NULL if there is none.
+ */
+const AssetEntry* asset_pack_find(const AssetPack* pack, const char* name,
+                                  AssetType type);
+
+/**
+ * @brief Gets the bytes of an entry.
+ * @param pack A constant pointer to the AssetPack.
+ * @param entry A constant pointer to one of its entries.
+ * @return A pointer into the mapped archive, valid until it is closed.
+ */
+const void* asset_pack_data(const AssetPack* pack, const AssetEntry* entry);
+
+/**
+ * @brief Opens a read-only stream over the bytes of an entry, for the
+ * loaders that take an SDL_RWops.
+ * @param pack A constant pointer to the AssetPack.
+ * @param entry A constant pointer to one of its entries.
+ * @return The stream, or NULL on failure.
+ */
+SDL_RWops* asset_pack_open_rw(const AssetPack* pack, const AssetEntry* entry);
+
+/**
+ * @brief Writes an archive.
+ * @param path The archive file to create.
+ * @param entries The entries; their offsets are filled in.
+ * @param data The bytes of each entry, `entries[i].size` long.
+ * @param count The number of entries, at most ASSET_PACK_MAX_ENTRIES.
+ * @return true on success, false if the file could not be written.
+ */
+bool asset_pack_write(const char* path, AssetEntry* entries,
+                      const void* const* data, int count);
+
+#endif  // ASSET_PACK_H
@@ -4,24 +4,113 @@
  *
  * This module manages the loading and playback of music and sound effects
  * using the SDL_mixer library.
+ *
+ * Sound effects go through a small voice manager rather than straight to the
+ * first free mixer channel. The number of channels is fixed at startup, each
+ * sound may only hold a few of them at once, and when every channel is busy
+ * a new sound replaces the oldest voice of the lowest priority, provided that
+ * priority does not outrank it. However many entities fire, the mixer never
+ * mixes more than the configured number of voices.
+ *
+ * Alternatively, sound effects can be mixed by the SIMD software mixer in
+ * sfx_mixer.h, hooked in after SDL_mixer's own mixing. It plays hundreds of
+ * voices at once, so it skips the caps and priorities and only replaces the
+ * oldest voice when all of them are busy.
+ *
+ * The device buffer size sets the output latency. In the adaptive mode the
+ * buffer starts small, the post-mix hook flags callbacks that arrive late
+ * enough for the device to have run dry, and audio_update() doubles the
+ * buffer after repeated underruns and halves it again once playback has
+ * been clean for a while.
  */
 
 #ifndef AUDIO_H
 #define AUDIO_H
 
+#include "core/asset_pack.h"
 #include "utils/types.h"
 
 // --- Public API ---
 
 /**
- * @brief Initializes the SDL_mixer subsystem and loads all audio assets.
+ * @brief Initializes the SDL_mixer subsystem and opens the audio device.
+ *
+ * No sounds or music are loaded yet; they are loaded with audio_load_sound()
+ * and audio_load_music(), possibly on a loader thread, and handed over with
+ * audio_attach_sounds() and audio_attach_music(). Until then, playing them
+ * does nothing.
  * @param audio A pointer to the AudioContext to be initialized.
+ * @param voice_count The number of mixer channels to play sound effects on,
+ * from 1 to MAX_AUDIO_VOICES.
+ * @param mixer Who mixes the sound effects. The software mixer needs a
+ * signed 16-bit stereo device; on any other, SDL_mixer is used instead.
+ * @param buffer_frames The sample frames per device callback, a power of
+ * two; 0 starts at AUDIO_LOW_LATENCY_FRAMES and adapts to underruns.
  * @return true on successful initialization, false otherwise.
  */
-bool audio_init(AudioContext* audio);
+bool audio_init(AudioContext* audio, int voice_count, AudioMixer mixer,
+                int buffer_frames);
 
 /**
- * @brief Frees all loaded audio assets and shuts down the audio subsystem.
+ * @brief Loads a sound effect at its mixing volume.
+ *
+ * Safe to call from a loader thread, as long as the device is not reopened
+ * meanwhile; audio_update() must not run until loading is done.
+ * @param pack A constant pointer to the asset archive, which may be empty;
+ * sounds it lacks are loaded from their loose files. It must stay open
+ * until the sound is freed.
+ * @param sound The sound effect to load.
+ * @return The chunk, or NULL on failure.
+ */
+Mix_Chunk* audio_load_sound(const AssetPack* pack, SoundId sound);
+
+/**
+ * @brief Loads the background music. Safe to call from a loader thread, like
+ * audio_load_sound().
+ * @param pack A constant pointer to the asset archive, which may be empty.
+ * It must stay open until the music is freed.
+ * @return The music, or NULL on failure.
+ */
+Mix_Music* audio_load_music(const AssetPack* pack);
+
+/**
+ * @brief Hands every sound effect to the context, which frees them at
+ * cleanup, and starts the software mixer if it was requested.
+ * @param audio A pointer to the AudioContext.
+ * @param sounds The chunks, indexed by SoundId; NULL for missing ones.
+ */
+void audio_attach_sounds(AudioContext* audio,
+                         Mix_Chunk* const sounds[SOUND_COUNT]);
+
+/**
+ * @brief Hands the background music to the context, which frees it at
+ * cleanup.
+ * @param audio A pointer to the AudioContext.
+ * @param music The music, or NULL if it failed to load.
+ */
+void audio_attach_music(AudioContext* audio, Mix_Music* music);
+
+/**
+ * @brief Collects the underruns seen by the audio thread and, in the
+ * adaptive mode, resizes the device buffer. Call once per frame.
+ *
+ * Resizing reopens the device, which cuts off the sounds playing on
+ * SDL_mixer's channels and restarts the music from its beginning.
+ * @param audio A pointer to the AudioContext.
+ */
+void audio_update(AudioContext* audio);
+
+/**
+ * @brief Computes the output latency the current buffer size adds.
+ * @param audio A constant pointer to the AudioContext.
+ * @return The length of one device buffer in milliseconds, or 0 if the
+ * device is closed.
+ */
+float audio_latency_ms(const AudioContext* audio);
+
+/**
+ * @brief Prints the voice manager and latency counters, frees all loaded
+ * audio assets and shuts down the audio subsystem.
  * @param audio A pointer to the AudioContext containing the resources to be
  * freed.
  */
@@ -36,11 +125,16 @@ void audio_cleanup(AudioContext* audio);
 void audio_play_music(AudioContext* audio, bool loop);
 
 /**
- * @brief Plays a sound effect on the first available channel.
- * @param audio A pointer to the AudioContext. This is currently unused but
- * is reserved for potential future stateful audio management.
- * @param sound A pointer to the Mix_Chunk sound effect to be played.
+ * @brief Plays a sound effect on a voice chosen by the voice manager.
+ *
+ * The sound takes a free channel if it is below its concurrency cap. At the
+ * cap it restarts its own oldest voice; with every channel busy it steals
+ * the oldest voice of the lowest priority no higher than its own, and is
+ * dropped if there is none. With the software mixer, the sound is queued
+ * for the audio thread instead, and only dropped if the queue is full.
+ * @param audio A pointer to the AudioContext.
+ * @param sound The sound effect to play.
  */
-void audio_play_sound(AudioContext* audio, Mix_Chunk* sound);
+void audio_play_sound(AudioContext* audio, SoundId sound);
 
 #endif  // AUDIO_H
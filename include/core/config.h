@@ -0,0 +1,83 @@
+/**
+ * @file config.h
+ * @brief Defines the startup configuration and its command-line/file parser.
+ *
+ * Settings can be given as long command-line options (e.g.
+ * `--max-projectiles 5000`) or in a config file loaded with `--config FILE`,
+ * one `name = value` pair per line using the same option names. Later
+ * settings override earlier ones.
+ */
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include "game/world.h"
+#include "utils/constants.h"
+#include "utils/types.h"
+
+/**
+ * @struct GameConfig
+ * @brief Holds every setting chosen at startup.
+ */
+typedef struct {
+  WorldConfig world;    ///< Pool capacities and simulation settings.
+  bool vsync;           ///< True to sync presentation to the display refresh.
+  bool random_seed;     ///< True if no seed was given and one should be
+                        ///< picked at startup.
+  bool show_help;       ///< True if the usage text was requested.
+  bool startup_report;  ///< True to print the startup and shutdown phase
+                        ///< times and exit once everything is loaded.
+  bool alloc_check;     ///< True to count heap allocations and fail if a
+                        ///< frame allocates after warm-up.
+  int threads;          ///< Threads to simulate on; 0 means one per core.
+  int voices;           ///< Mixer channels for sound effects.
+  AudioMixer mixer;     ///< Who mixes the sound effects.
+  int audio_buffer;     ///< Sample frames per audio callback; 0 adapts the
+                        ///< size to underruns, starting small.
+  char trace_path[MAX_PATH_LENGTH];   ///< Trace output file; empty when
+                                      ///< tracing is off.
+  char record_path[MAX_PATH_LENGTH];  ///< Replay file to record; empty when
+                                      ///< not recording.
+  char replay_path[MAX_PATH_LENGTH];  ///< Replay file to play back; empty
+                                      ///< for live input.
+  char record_hashes_path[MAX_PATH_LENGTH];  ///< File to record per-tick
+                                             ///< world hashes to, or empty.
+  char verify_hashes_path[MAX_PATH_LENGTH];  ///< Reference hashes to verify
+                                             ///< every tick against, or
+                                             ///< empty.
+} GameConfig;
+
+// --- Public API ---
+
+/**
+ * @brief Fills a GameConfig with the default settings.
+ * @param config A pointer to the GameConfig to fill.
+ */
+void config_init(GameConfig* config);
+
+/**
+ * @brief Applies the settings from a config file.
+ *
+ * Blank lines and lines starting with `#` are ignored.
+ * @param config A pointer to the GameConfig to update.
+ * @param path The path of the config file.
+ * @return true if the file was read and every setting was valid.
+ */
+bool config_load_file(GameConfig* config, const char* path);
+
+/**
+ * @brief Applies the settings from the command line.
+ * @param config A pointer to the GameConfig to update.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line argument strings, including the program name.
+ * @return true if every option was recognized and valid.
+ */
+bool config_parse_args(GameConfig* config, int argc, char* argv[]);
+
+/**
+ * @brief Prints the list of supported options to stdout.
+ * @param program The program name to show in the usage line.
+ */
+void config_print_usage(const char* program);
+
+#endif  // CONFIG_H
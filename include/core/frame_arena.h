@@ -0,0 +1,93 @@
+/**
+ * @file frame_arena.h
+ * @brief Defines a double-buffered linear arena for per-frame scratch memory.
+ *
+ * Data that only lives for a frame, such as formatted text, vertex lists or
+ * candidate lists, is bump-allocated from the frame arena instead of the
+ * heap or a fixed stack buffer. Two arenas take turns: the game loop calls
+ * frame_arena_begin() at the top of every frame, which switches to the
+ * other arena and resets it. Memory handed out during one frame therefore
+ * stays valid through the next, for data that must survive one frame (such
+ * as last frame's results), and is reused after that.
+ *
+ * The frame arena is not thread-safe; request memory on the main thread
+ * and hand it to workers.
+ */
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/arena.h"
+
+/**
+ * @struct FrameArena
+ * @brief Two arenas used on alternate frames, with usage statistics.
+ */
+typedef struct FrameArena {
+  Arena buffers[2];   ///< The arenas of alternate frames.
+  int current;        ///< The arena the current frame allocates from.
+  size_t high_water;  ///< Most bytes one frame has used since startup.
+  int overflows;      ///< Requests that did not fit, since startup.
+} FrameArena;
+
+// --- Public API ---
+
+/**
+ * @brief Allocates both arenas.
+ * @param arena A pointer to the FrameArena to initialize.
+ * @param capacity The number of bytes one frame can use.
+ * @return true on success, false if an allocation failed.
+ */
+bool frame_arena_init(FrameArena* arena, size_t capacity);
+
+/**
+ * @brief Frees both arenas.
+ * @param arena A pointer to the FrameArena to destroy.
+ */
+void frame_arena_destroy(FrameArena* arena);
+
+/**
+ * @brief Starts a new frame: switches to the arena used two frames ago and
+ * resets it. Everything allocated before the previous frame is gone.
+ * @param arena A pointer to the FrameArena.
+ */
+void frame_arena_begin(FrameArena* arena);
+
+/**
+ * @brief Hands out uninitialized memory that lasts until the end of the
+ * next frame.
+ * @param arena A pointer to the FrameArena.
+ * @param size The number of bytes requested.
+ * @param alignment The required alignment, a power of two no larger than
+ * ARENA_DEFAULT_ALIGNMENT.
+ * @return A pointer to the memory, or NULL if this frame's arena is full.
+ */
+void* frame_arena_alloc(FrameArena* arena, size_t size, size_t alignment);
+
+/**
+ * @brief Formats a string into memory from the frame arena.
+ * @param arena A pointer to the FrameArena.
+ * @param format The printf()-style format string.
+ * @return The formatted string, or NULL if this frame's arena is full.
+ */
+char* frame_arena_printf(FrameArena* arena, const char* format, ...)
+    SDL_PRINTF_VARARG_FUNC(2);
+
+/**
+ * @brief Gets the number of bytes used by the current frame so far.
+ * @param arena A constant pointer to the FrameArena.
+ * @return The bytes used.
+ */
+size_t frame_arena_used(const FrameArena* arena);
+
+/**
+ * @brief Hands back everything allocated since an earlier point of the
+ * current frame, so a pass that runs several times per frame can reuse the
+ * same memory each time.
+ * @param arena A pointer to the FrameArena.
+ * @param used The value frame_arena_used() returned at that point, in the
+ * same frame.
+ */
+void frame_arena_rewind(FrameArena* arena, size_t used);
+
+#endif  // FRAME_ARENA_H
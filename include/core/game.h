@@ -9,6 +9,13 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "core/asset_loader.h"
+#include "core/asset_pack.h"
+#include "core/config.h"
+#include "core/frame_arena.h"
+#include "core/thread_pool.h"
+#include "game/hash_trace.h"
+#include "game/replay.h"
 #include "game/world.h"
 #include "utils/types.h"
 
@@ -23,14 +30,35 @@
  * like the current scene and menu selections.
  */
 typedef struct {
+  GameConfig config;         ///< The settings chosen at startup.
   RendererContext renderer;  ///< The rendering subsystem context.
+  FrameArena frame_arena;    ///< Scratch memory for the current frame.
+  AssetPack assets;          ///< The mapped asset archive; empty when the
+                             ///< loose asset files are used.
   AudioContext audio;        ///< The audio subsystem context.
+  AssetLoader loader;        ///< Loads the assets in the background.
   InputState input;          ///< The current frame's input state.
   World world;               ///< The gameplay world state.
+  ThreadPool thread_pool;    ///< Workers that share the world update.
   GameStateEnum
-      current_state;  ///< The current game scene (e.g., menu, playing).
-  bool is_running;    ///< The main application loop condition flag.
-  int menu_option;    ///< The currently selected menu option index.
+      current_state;    ///< The current game scene (e.g., menu, playing).
+  bool is_running;      ///< The main application loop condition flag.
+  int menu_option;      ///< The currently selected menu option index.
+  bool fire_requested;  ///< A shot was requested this frame and is fired on
+                        ///< the next simulation tick.
+  Replay replay;        ///< Input played back instead of the player's, if
+                        ///< open.
+  Replay recording;     ///< Where each tick's input is recorded, if open.
+  HashTrace hashes;     ///< Where each tick's world hash is recorded, if
+                        ///< open.
+  HashTrace reference;  ///< Hashes each tick is verified against, if open.
+  bool presented;       ///< True once the first frame was presented.
+  int alloc_warmup;     ///< Frames left before --alloc-check starts.
+  int alloc_resizes;    ///< Audio buffer resizes seen by --alloc-check.
+  int checked_frames;   ///< Frames checked by --alloc-check.
+  int alloc_frames;     ///< Checked frames that allocated.
+  Uint8 tick_keys[SDL_NUM_SCANCODES];  ///< Keyboard state seen by the world
+                                       ///< on the current tick.
 } Game;
 
 // --- Public API ---
@@ -38,15 +66,19 @@ typedef struct {
 /**
  * @brief Initializes all game subsystems and sets the initial game state.
  * @param game A pointer to the main Game struct to be initialized.
+ * @param config A constant pointer to the startup settings, which are copied
+ * into the Game.
  * @return true on successful initialization of all subsystems, false otherwise.
  */
-bool game_init(Game* game);
+bool game_init(Game* game, const GameConfig* config);
 
 /**
  * @brief Runs the main game loop, which handles input, updates, and rendering.
  *
- * This function contains the core application loop and will not return until
- * the game is closed.
+ * Input is polled and a frame is rendered once per loop iteration, while the
+ * simulation advances in fixed ticks at the configured rate: as many as the
+ * elapsed time calls for, up to MAX_TICKS_PER_FRAME. This function will not
+ * return until the game is closed.
  * @param game A pointer to the initialized Game struct.
  */
 void game_run(Game* game);
@@ -55,7 +87,9 @@ void game_run(Game* game);
  * @brief Cleans up all resources used by the game and shuts down SDL
  * subsystems.
  * @param game A pointer to the Game struct whose resources will be freed.
+ * @return false if --alloc-check caught a frame allocating, or if a hash
+ * file failed as hash_trace_close() reports, true otherwise.
  */
-void game_cleanup(Game* game);
+bool game_cleanup(Game* game);
 
 #endif  // GAME_H
@@ -0,0 +1,75 @@
+/**
+ * @file glyph_atlas.h
+ * @brief Defines the glyph atlas used to draw text without per-call texture
+ * uploads.
+ *
+ * Each font's printable ASCII characters are rendered once, at startup, into
+ * a single texture; the rendering can happen off the render thread, and only
+ * the upload on it. Strings are then drawn as batches of textured quads
+ * sampling that texture, so steady-state text rendering performs no
+ * allocations, no surface rendering and no texture uploads.
+ */
+
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include "utils/types.h"
+
+// --- Public API ---
+
+/**
+ * @brief Renders every printable ASCII glyph of a font into one sheet and
+ * fills in the atlas' glyph rectangles, kerning and line height.
+ *
+ * This is the CPU half of building an atlas and touches no renderer, so it
+ * may run on a loader thread, provided no other thread uses SDL_ttf.
+ * @param atlas A pointer to the GlyphAtlas to build; its texture is cleared.
+ * @param font The font to render.
+ * @return The glyph sheet for glyph_atlas_upload(), or NULL on failure.
+ */
+SDL_Surface* glyph_atlas_build(GlyphAtlas* atlas, TTF_Font* font);
+
+/**
+ * @brief Uploads a glyph sheet as the atlas texture. Render thread only.
+ * @param atlas A pointer to the GlyphAtlas filled in by glyph_atlas_build().
+ * @param renderer The renderer that will own the atlas texture.
+ * @param sheet The sheet returned by glyph_atlas_build(); it is freed.
+ * @return true on success, false if the texture could not be created.
+ */
+bool glyph_atlas_upload(GlyphAtlas* atlas, SDL_Renderer* renderer,
+                        SDL_Surface* sheet);
+
+/**
+ * @brief Frees the atlas texture.
+ * @param atlas A pointer to the GlyphAtlas to destroy.
+ */
+void glyph_atlas_destroy(GlyphAtlas* atlas);
+
+/**
+ * @brief Computes the size of a string as drawn by glyph_atlas_draw().
+ *
+ * Characters outside printable ASCII are measured as '?'.
+ * @param atlas A constant pointer to the GlyphAtlas.
+ * @param text The null-terminated string to measure.
+ * @param w A pointer that receives the width in pixels.
+ * @param h A pointer that receives the height in pixels.
+ */
+void glyph_atlas_measure(const GlyphAtlas* atlas, const char* text, int* w,
+                         int* h);
+
+/**
+ * @brief Draws a string with its top-left corner at the given position.
+ *
+ * Characters outside printable ASCII are drawn as '?'.
+ * @param atlas A constant pointer to the GlyphAtlas.
+ * @param renderer The renderer to draw with.
+ * @param text The null-terminated string to draw.
+ * @param x The X coordinate of the top-left corner.
+ * @param y The Y coordinate of the top-left corner.
+ * @param color The color of the text.
+ * @return The number of draw calls issued.
+ */
+int glyph_atlas_draw(const GlyphAtlas* atlas, SDL_Renderer* renderer,
+                     const char* text, float x, float y, SDL_Color color);
+
+#endif  // GLYPH_ATLAS_H
@@ -0,0 +1,118 @@
+/**
+ * @file profiler.h
+ * @brief Defines a lightweight per-frame profiler built on
+ * SDL_GetPerformanceCounter().
+ *
+ * The game loop is split into zones timed with PROFILE_BEGIN()/PROFILE_END().
+ * Time spent in a zone is summed over the frame, so zones run several times
+ * per frame (such as simulation ticks) report their total. The last
+ * PROFILER_HISTORY_FRAMES frames are kept in a ring buffer for the on-screen
+ * overlay and written to a CSV file at shutdown.
+ *
+ * With the allocation tracker installed (`--alloc-check`), each zone also
+ * counts the heap allocations made while it runs, on any thread.
+ *
+ * Profiling is only compiled in when STARFALL_PROFILE is defined (build with
+ * `make PROFILE=1`). Otherwise every macro expands to nothing and the
+ * profiler costs nothing at runtime.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "core/alloc_tracker.h"
+#include "utils/types.h"
+
+/**
+ * @enum ProfileZone
+ * @brief The timed sections of a frame.
+ */
+typedef enum {
+  PROFILE_ZONE_FRAME,         ///< The whole frame, including the vsync wait.
+  PROFILE_ZONE_INPUT,         ///< game_handle_input().
+  PROFILE_ZONE_WORLD_UPDATE,  ///< world_update(), summed over all ticks.
+  PROFILE_ZONE_COLLISIONS,    ///< world_check_collisions(), likewise.
+  PROFILE_ZONE_RENDER,        ///< Drawing the scene into the game texture.
+  PROFILE_ZONE_PRESENT,       ///< renderer_present_frame().
+  PROFILE_ZONE_COUNT          ///< Number of zones.
+} ProfileZone;
+
+/**
+ * @struct ProfileZoneStats
+ * @brief Summary of one zone over the frames in the history.
+ */
+typedef struct {
+  float min_ms;       ///< Fastest frame.
+  float avg_ms;       ///< Mean over the history.
+  float p99_ms;       ///< 99th percentile.
+  Uint32 max_allocs;  ///< Most allocations made in one frame.
+} ProfileZoneStats;
+
+#ifdef STARFALL_PROFILE
+/// Starts timing a zone; must be paired with PROFILE_END() in the same scope.
+#define PROFILE_BEGIN(zone)                                   \
+  AllocCounts profile_allocs_##zone = alloc_tracker_totals(); \
+  Uint64 profile_start_##zone = SDL_GetPerformanceCounter()
+/// Stops timing a zone and adds the elapsed time and the allocations made
+/// to the current frame.
+#define PROFILE_END(zone)                                                   \
+  profiler_record(zone, SDL_GetPerformanceCounter() - profile_start_##zone, \
+                  alloc_tracker_since(profile_allocs_##zone))
+/// Closes the current frame and stores its zone times in the history.
+#define PROFILE_FRAME_END() profiler_end_frame()
+#else
+#define PROFILE_BEGIN(zone) ((void)0)
+#define PROFILE_END(zone) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
+
+// --- Public API ---
+// Only available when STARFALL_PROFILE is defined.
+
+/**
+ * @brief Clears the history and prepares the profiler for the first frame.
+ */
+void profiler_init(void);
+
+/**
+ * @brief Writes the history to PROFILER_CSV_PATH, one row per frame.
+ */
+void profiler_shutdown(void);
+
+/**
+ * @brief Adds time spent in a zone to the current frame.
+ * @param zone The zone that was timed.
+ * @param elapsed The elapsed time, in performance counter ticks.
+ * @param allocs The allocations made meanwhile.
+ */
+void profiler_record(ProfileZone zone, Uint64 elapsed, AllocCounts allocs);
+
+/**
+ * @brief Closes the current frame and stores it in the history.
+ */
+void profiler_end_frame(void);
+
+/**
+ * @brief Computes the min/avg/p99 time and the peak allocations of a zone
+ * over the frames in the history.
+ * @param zone The zone to summarize.
+ * @param stats A pointer that receives the summary.
+ * @return The number of frames summarized; 0 if the history is empty.
+ */
+int profiler_get_stats(ProfileZone zone, ProfileZoneStats* stats);
+
+/**
+ * @brief Gets the allocations a zone made in the last closed frame.
+ * @param zone The zone to look up.
+ * @return The allocations; zero if no frame was closed yet.
+ */
+AllocCounts profiler_last_allocs(ProfileZone zone);
+
+/**
+ * @brief Returns the display name of a zone.
+ * @param zone The zone to name.
+ * @return A short, static name such as "collisions".
+ */
+const char* profiler_zone_name(ProfileZone zone);
+
+#endif  // PROFILER_H
@@ -11,6 +11,7 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include "core/frame_arena.h"
 #include "game/world.h"
 #include "utils/types.h"
 
@@ -18,11 +19,19 @@
 
 // Lifecycle Functions
 /**
- * @brief Initializes the SDL window, renderer, and loads all graphical assets.
+ * @brief Initializes the SDL window and renderer.
+ *
+ * The fonts and the background are loaded by the asset loader and attached
+ * afterwards; until then, text and the background are not drawn.
  * @param context A pointer to the RendererContext to be initialized.
+ * @param vsync If true, presenting a frame waits for the display refresh;
+ * otherwise frames are presented as fast as they are drawn.
+ * @param frame_arena A pointer to the FrameArena that formatted text is
+ * allocated from; it must outlive the renderer.
  * @return true on successful initialization, false otherwise.
  */
-bool renderer_init(RendererContext* context);
+bool renderer_init(RendererContext* context, bool vsync,
+                   FrameArena* frame_arena);
 
 /**
  * @brief Frees all graphical assets and shuts down the rendering subsystem.
@@ -50,10 +59,17 @@ void renderer_present_frame(RendererContext* context);
 // State-specific Rendering
 /**
  * @brief Renders the active gameplay scene, including all entities.
+ *
+ * Entities are drawn between their positions at the previous and the latest
+ * simulation tick, so motion stays smooth when frames and ticks do not line
+ * up.
  * @param context A pointer to the RendererContext for drawing operations.
  * @param world A constant pointer to the game world containing entity data.
+ * @param alpha How far the frame lies between the previous tick (0.0) and the
+ * latest tick (1.0).
  */
-void renderer_draw_game(RendererContext* context, const World* world);
+void renderer_draw_game(RendererContext* context, const World* world,
+                        float alpha);
 
 /**
  * @brief Renders the Heads-Up Display (score, lives, etc.) over the game scene.
@@ -79,6 +95,24 @@ void renderer_draw_menu(RendererContext* context, int selected_option);
 void renderer_draw_game_over(RendererContext* context, const World* world,
                              int selected_option);
 
+/**
+ * @brief Renders the loading screen: a progress bar, since no font may be
+ * available yet.
+ * @param context A pointer to the RendererContext for drawing operations.
+ * @param progress The fraction of the assets loaded, from 0.0 to 1.0.
+ */
+void renderer_draw_loading(RendererContext* context, float progress);
+
+/**
+ * @brief Renders the debug overlay with the draw calls of the last frame,
+ * the audio output latency and, in profiling builds, the per-zone frame
+ * times.
+ * @param context A pointer to the RendererContext for drawing operations.
+ * @param audio A constant pointer to the AudioContext, for its buffer size
+ * and underruns.
+ */
+void renderer_draw_debug(RendererContext* context, const AudioContext* audio);
+
 // Utility Functions
 /**
  * @brief Toggles the window between fullscreen desktop and windowed mode.
@@ -0,0 +1,123 @@
+/**
+ * @file sfx_mixer.h
+ * @brief Defines a software mixer for large numbers of short sound effects.
+ *
+ * SDL_mixer mixes each of its channels separately and only has a handful of
+ * them. This mixer instead sums hundreds of voices into one float
+ * accumulator with SIMD kernels and adds the result to the device stream
+ * with saturation, so it can run as SDL_mixer's post-mix hook on top of the
+ * music.
+ *
+ * Sounds must already be in the device format, interleaved signed 16-bit
+ * stereo; chunks loaded by SDL_mixer are converted to it when loaded. The
+ * game thread starts sounds by pushing commands into a single-producer,
+ * single-consumer ring, and the audio thread drains the ring at the start of
+ * each buffer. Neither side ever takes a lock or waits for the other.
+ */
+
+#ifndef SFX_MIXER_H
+#define SFX_MIXER_H
+
+#include "utils/constants.h"
+#include "utils/types.h"
+
+/**
+ * @struct SfxSound
+ * @brief A sound effect in the device format.
+ */
+typedef struct {
+  const Sint16* samples;  ///< Interleaved stereo samples, or NULL if unset.
+  int frames;             ///< Number of stereo frames.
+} SfxSound;
+
+/**
+ * @struct SfxCommand
+ * @brief A request from the game thread to start a sound.
+ */
+typedef struct {
+  int sound;   ///< The sound to start.
+  float gain;  ///< Linear volume, 1.0 for unchanged.
+} SfxCommand;
+
+/**
+ * @struct SfxVoice
+ * @brief A sound being played by the audio thread.
+ */
+typedef struct {
+  const Sint16* samples;  ///< The sound's samples.
+  int frames;             ///< Length of the sound in frames.
+  int position;           ///< Next frame to mix.
+  float gain;             ///< Linear volume.
+  Uint64 started;         ///< Start order; lower is older.
+} SfxVoice;
+
+/**
+ * @struct SfxMixer
+ * @brief The sounds, command ring and voices of the software mixer.
+ *
+ * `sounds` are set before the mixer is handed to the audio thread and never
+ * change afterwards. The command ring is shared; everything after it belongs
+ * to the audio thread.
+ */
+typedef struct SfxMixer {
+  SfxSound sounds[SFX_MAX_SOUNDS];        ///< Sound effects by index.
+  SfxCommand commands[SFX_COMMAND_RING];  ///< Ring of pending commands.
+  SDL_atomic_t command_head;              ///< Commands pushed by the game.
+  SDL_atomic_t command_tail;              ///< Commands taken by the mixer.
+  SfxVoice voices[SFX_MAX_VOICES];        ///< Playing voices, densely packed.
+  int voice_count;                        ///< Number of playing voices.
+  Uint64 next_voice;                      ///< Start order of the next voice.
+  Uint64 started;                         ///< Voices started so far.
+  Uint64 stolen;                          ///< Voices cut short by a new one.
+  float mix[SFX_MIX_BLOCK_FRAMES * 2];    ///< Accumulator of one block.
+} SfxMixer;
+
+// --- Public API ---
+
+/**
+ * @brief Clears a mixer: no sounds, no voices and an empty command ring.
+ * @param mixer A pointer to the SfxMixer to initialize.
+ */
+void sfx_mixer_init(SfxMixer* mixer);
+
+/**
+ * @brief Sets the samples of a sound effect.
+ *
+ * Must be called before the mixer is used from the audio thread. The
+ * samples are not copied and must outlive the mixer.
+ * @param mixer A pointer to the SfxMixer.
+ * @param sound The index of the sound, below SFX_MAX_SOUNDS.
+ * @param samples Interleaved signed 16-bit stereo samples.
+ * @param frames The number of stereo frames.
+ */
+void sfx_mixer_set_sound(SfxMixer* mixer, int sound, const Sint16* samples,
+                         int frames);
+
+/**
+ * @brief Asks the audio thread to start a sound. Game thread only.
+ * @param mixer A pointer to the SfxMixer.
+ * @param sound The index of a sound set with sfx_mixer_set_sound().
+ * @param gain The linear volume, 1.0 for unchanged.
+ * @return true if the command was queued, false if the ring was full.
+ */
+bool sfx_mixer_play(SfxMixer* mixer, int sound, float gain);
+
+/**
+ * @brief Starts the queued sounds and adds every playing voice to a stream.
+ * Audio thread only.
+ *
+ * The voices are added to what the stream already holds, saturating at the
+ * 16-bit limits. When every voice is busy, a new sound replaces the oldest.
+ * @param mixer A pointer to the SfxMixer.
+ * @param stream Interleaved signed 16-bit stereo samples to add to.
+ * @param frames The number of stereo frames in the stream.
+ */
+void sfx_mixer_mix(SfxMixer* mixer, Sint16* stream, int frames);
+
+/**
+ * @brief Names the mixing kernels compiled into this build.
+ * @return "SSE2" or "scalar".
+ */
+const char* sfx_mixer_kernel_name(void);
+
+#endif  // SFX_MIXER_H
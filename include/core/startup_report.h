@@ -0,0 +1,93 @@
+/**
+ * @file startup_report.h
+ * @brief Defines the timing of the startup and shutdown phases.
+ *
+ * Each expensive step between launch and the first fully loaded frame, and
+ * each step of the cleanup, is timed with SDL_GetPerformanceCounter(). Steps
+ * on the asset loader thread are timed too, so the report shows how much of
+ * the loading overlapped with the main thread.
+ *
+ * Timing is always on, since it costs two counter reads per phase; the
+ * breakdown is only printed with `--startup-report`.
+ */
+
+#ifndef STARTUP_REPORT_H
+#define STARTUP_REPORT_H
+
+#include "utils/types.h"
+
+/**
+ * @enum StartupPhase
+ * @brief The timed steps, in the order they are reported.
+ */
+typedef enum {
+  // Startup, on the main thread.
+  STARTUP_PHASE_SDL_INIT,        ///< SDL_Init().
+  STARTUP_PHASE_ASSET_PACK,      ///< Mapping the asset archive.
+  STARTUP_PHASE_TTF_INIT,        ///< TTF_Init().
+  STARTUP_PHASE_WINDOW,          ///< SDL_CreateWindow().
+  STARTUP_PHASE_RENDERER,        ///< SDL_CreateRenderer().
+  STARTUP_PHASE_GAME_TEXTURE,    ///< Creating the logical render target.
+  STARTUP_PHASE_OPEN_AUDIO,      ///< Mix_OpenAudio() and channel setup.
+  STARTUP_PHASE_WORLD,           ///< world_init().
+  STARTUP_PHASE_THREAD_POOL,     ///< thread_pool_init().
+  // Startup, on the asset loader thread.
+  STARTUP_PHASE_FONT_NORMAL,     ///< Opening the normal font and its atlas.
+  STARTUP_PHASE_FONT_LARGE,      ///< Opening the large font and its atlas.
+  STARTUP_PHASE_FONT_SMALL,      ///< Opening the small font and its atlas.
+  STARTUP_PHASE_BACKGROUND,      ///< Decoding the background image.
+  STARTUP_PHASE_SOUNDS,          ///< Loading the sound effects.
+  STARTUP_PHASE_MUSIC,           ///< Loading the music.
+  // Startup milestones, which have no duration.
+  STARTUP_PHASE_FIRST_FRAME,     ///< The first frame was presented.
+  STARTUP_PHASE_LOADED_FRAME,    ///< The first frame with every asset.
+  // Shutdown, in game_cleanup().
+  STARTUP_PHASE_SHUTDOWN,        ///< All of game_cleanup().
+  STARTUP_PHASE_STOP_LOADER,     ///< Stopping the asset loader.
+  STARTUP_PHASE_STOP_WORKERS,    ///< Joining the thread pool.
+  STARTUP_PHASE_FREE_WORLD,      ///< world_destroy().
+  STARTUP_PHASE_CLOSE_RENDERER,  ///< renderer_cleanup().
+  STARTUP_PHASE_CLOSE_AUDIO,     ///< audio_cleanup().
+  STARTUP_PHASE_SDL_QUIT,        ///< SDL_Quit().
+  STARTUP_PHASE_COUNT            ///< Number of phases.
+} StartupPhase;
+
+// --- Public API ---
+
+/**
+ * @brief Clears every phase and makes now the origin of the startup times.
+ * Call first thing at launch.
+ */
+void startup_report_init(void);
+
+/**
+ * @brief Starts timing a phase. Each phase is timed at most once, and from
+ * one thread only.
+ * @param phase The phase that begins.
+ */
+void startup_phase_begin(StartupPhase phase);
+
+/**
+ * @brief Stops timing a phase started with startup_phase_begin().
+ * @param phase The phase that ends.
+ */
+void startup_phase_end(StartupPhase phase);
+
+/**
+ * @brief Records a milestone, a phase that ends as soon as it begins.
+ * @param phase The milestone reached.
+ */
+void startup_phase_mark(StartupPhase phase);
+
+/**
+ * @brief Prints when each startup phase began and how long it took. Call
+ * once the loader thread has finished.
+ */
+void startup_report_print_startup(void);
+
+/**
+ * @brief Prints how long each shutdown phase took.
+ */
+void startup_report_print_shutdown(void);
+
+#endif  // STARTUP_REPORT_H
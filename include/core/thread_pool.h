@@ -0,0 +1,103 @@
+/**
+ * @file thread_pool.h
+ * @brief Defines a small pool of worker threads for data-parallel loops.
+ *
+ * The pool runs one loop at a time. A loop over `count` items is cut into
+ * fixed-size chunks, and every thread, including the caller, starts on its
+ * own contiguous share of them. A thread that finishes its share steals the
+ * remaining chunks of the others, so an uneven load still keeps every core
+ * busy. Chunk boundaries depend only on the item count and the chunk size,
+ * never on the number of threads, so results written per chunk are the same
+ * however many threads ran them.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "utils/constants.h"
+#include "utils/types.h"
+
+/**
+ * @brief The body of a parallel loop.
+ * @param context The pointer passed to thread_pool_parallel_for().
+ * @param begin The first item of the chunk; a multiple of the chunk size.
+ * @param end One past the last item of the chunk.
+ */
+typedef void (*ThreadPoolTask)(void* context, int begin, int end);
+
+/**
+ * @struct ThreadPoolQueue
+ * @brief The chunks assigned to one thread for the current loop.
+ *
+ * Each queue is aligned to and fills its own 64-byte cache line, so claiming
+ * chunks from it does not slow down the other threads. Pools are only ever
+ * declared as variables, where the compiler honors the alignment.
+ */
+typedef struct {
+  _Alignas(64) SDL_atomic_t next;  ///< Next unclaimed chunk; may pass end.
+  int end;                         ///< One past the last chunk of the share.
+} ThreadPoolQueue;
+
+struct ThreadPool;
+
+/**
+ * @struct ThreadPoolWorker
+ * @brief What a worker thread needs to find its pool and its queue.
+ */
+typedef struct {
+  struct ThreadPool* pool;  ///< The owning pool.
+  int index;                ///< The worker's queue; 0 is the caller.
+  SDL_Thread* thread;       ///< The thread, or NULL for the caller.
+} ThreadPoolWorker;
+
+/**
+ * @struct ThreadPool
+ * @brief A set of worker threads and the loop they are running.
+ */
+typedef struct ThreadPool {
+  int thread_count;  ///< Threads taking part in a loop, including the caller.
+  ThreadPoolWorker workers[THREAD_POOL_MAX_THREADS];  ///< One per thread.
+  ThreadPoolQueue queues[THREAD_POOL_MAX_THREADS];    ///< One per thread.
+  SDL_sem* start;      ///< Posted once per worker when a loop begins.
+  SDL_sem* done;       ///< Posted by each worker when it runs out of chunks.
+  SDL_atomic_t quit;   ///< Set to make the workers exit.
+  ThreadPoolTask task;  ///< Body of the current loop.
+  void* context;        ///< Argument of the current loop.
+  int count;            ///< Items in the current loop.
+  int chunk_size;       ///< Items per chunk in the current loop.
+} ThreadPool;
+
+// --- Public API ---
+
+/**
+ * @brief Starts the worker threads.
+ * @param pool A pointer to the ThreadPool to initialize.
+ * @param thread_count The number of threads to run loops on, including the
+ * caller; 0 picks one per CPU core. Clamped to THREAD_POOL_MAX_THREADS.
+ * @return true on success, false if a thread or semaphore could not be
+ * created.
+ */
+bool thread_pool_init(ThreadPool* pool, int thread_count);
+
+/**
+ * @brief Stops and joins the worker threads.
+ * @param pool A pointer to the ThreadPool to destroy.
+ */
+void thread_pool_destroy(ThreadPool* pool);
+
+/**
+ * @brief Runs a task over `count` items in chunks of `chunk_size` and waits
+ * until every chunk is done.
+ *
+ * With a NULL pool, a single thread, or a single chunk, the chunks run in
+ * order on the calling thread without waking any worker.
+ * @param pool A pointer to the ThreadPool, or NULL to run serially.
+ * @param count The number of items.
+ * @param chunk_size The number of items per chunk.
+ * @param task The loop body, called once per chunk.
+ * @param context An argument passed through to every call of the task.
+ */
+void thread_pool_parallel_for(ThreadPool* pool, int count, int chunk_size,
+                              ThreadPoolTask task, void* context);
+
+#endif  // THREAD_POOL_H
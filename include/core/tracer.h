@@ -0,0 +1,67 @@
+/**
+ * @file tracer.h
+ * @brief Defines an event tracer that exports a timeline in the Chrome
+ * trace-event format.
+ *
+ * Where the profiler summarizes zones over many frames, the tracer keeps
+ * every begin/end event with its timestamp and thread, so a single slow frame
+ * can be inspected in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Tracing is enabled at runtime with `--trace FILE`. Events are appended to a
+ * buffer allocated once at startup; a slot is claimed with a single atomic
+ * add, so recording never locks or allocates and is safe from any thread.
+ * When the buffer is full further events are dropped. The file is written
+ * at shutdown, once every thread that records events has stopped. While
+ * tracing is off, each TRACE_BEGIN()/TRACE_END() costs one atomic load and
+ * a branch.
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include "utils/types.h"
+
+/// Nonzero while events are being recorded. Read by the TRACE_* macros only.
+extern SDL_atomic_t tracer_enabled;
+
+/// Marks the start of a span; name must be a string literal.
+#define TRACE_BEGIN(name)               \
+  do {                                  \
+    if (SDL_AtomicGet(&tracer_enabled)) \
+      tracer_record((name), 'B');       \
+  } while (0)
+/// Marks the end of the span opened by the matching TRACE_BEGIN().
+#define TRACE_END(name)                 \
+  do {                                  \
+    if (SDL_AtomicGet(&tracer_enabled)) \
+      tracer_record((name), 'E');       \
+  } while (0)
+
+// --- Public API ---
+
+/**
+ * @brief Allocates the event buffer and starts recording.
+ * @param path The file the trace is written to by tracer_shutdown().
+ * @return true on success, false if the buffer could not be allocated.
+ */
+bool tracer_init(const char* path);
+
+/**
+ * @brief Stops recording, writes the trace file and frees the buffer.
+ *
+ * Must only be called once every other thread that records events (thread
+ * pool workers, the asset loader and the audio callback) has stopped, since
+ * a thread may still be filling the slot it claimed. Does nothing if
+ * tracer_init() was not called.
+ */
+void tracer_shutdown(void);
+
+/**
+ * @brief Records one event for the calling thread.
+ * @param name The span name. Only the pointer is stored, so it must outlive
+ * the tracer (string literals do).
+ * @param phase 'B' for a span start or 'E' for a span end.
+ */
+void tracer_record(const char* name, char phase);
+
+#endif  // TRACER_H
@@ -0,0 +1,60 @@
+/**
+ * @file bot.h
+ * @brief Defines the computer players that produce a TickInput from the world
+ * state.
+ *
+ * Bots stand in for a human in headless runs. They only read the world they
+ * are given, so one bot per world can run on any number of threads at once,
+ * and the same world always gets the same input.
+ */
+
+#ifndef BOT_H
+#define BOT_H
+
+#include "game/replay.h"
+#include "game/world.h"
+#include "utils/types.h"
+
+/**
+ * @enum BotKind
+ * @brief The available bot behaviors.
+ */
+typedef enum {
+  BOT_SCRIPTED,    ///< Sweeps a fixed pattern, ignoring threats.
+  BOT_EVASIVE,     ///< Steers away from nearby enemies and enemy shots.
+  BOT_KIND_COUNT,  ///< Number of bot kinds.
+} BotKind;
+
+// --- Public API ---
+
+/**
+ * @brief Generates a bot's input for the current tick.
+ *
+ * Both bots shoot every BOT_FIRE_PERIOD ticks. The scripted bot cycles
+ * through the eight directions, holding each for BOT_MOVE_PERIOD ticks, and
+ * aims at the oldest live enemy. The evasive bot moves away from the threats
+ * within BOT_DANGER_RADIUS, drifts back to the center when none is near, and
+ * aims at the closest enemy.
+ * @param kind The behavior to use.
+ * @param world A constant pointer to the world the bot plays in.
+ * @param tick The index of the current tick.
+ * @param input A pointer to the TickInput to fill.
+ */
+void bot_tick(BotKind kind, const World* world, Uint64 tick, TickInput* input);
+
+/**
+ * @brief Looks up a bot kind by its command-line name.
+ * @param name "script" or "evade".
+ * @param out A pointer that receives the kind.
+ * @return true if the name is known.
+ */
+bool bot_parse_kind(const char* name, BotKind* out);
+
+/**
+ * @brief Returns the command-line name of a bot kind.
+ * @param kind The bot kind.
+ * @return The name, as accepted by bot_parse_kind().
+ */
+const char* bot_kind_name(BotKind kind);
+
+#endif  // BOT_H
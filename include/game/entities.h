@@ -17,44 +17,98 @@
  * @brief Represents the state of the player's ship.
  */
 typedef struct {
-  float x;     ///< The X coordinate of the player's center.
-  float y;     ///< The Y coordinate of the player's center.
+  float x;       ///< The X coordinate of the player's center.
+  float y;       ///< The Y coordinate of the player's center.
+  float prev_x;  ///< The X coordinate at the end of the previous tick.
+  float prev_y;  ///< The Y coordinate at the end of the previous tick.
   int radius;  ///< The collision radius of the player.
   int lives;   ///< The number of remaining lives.
 } Player;
 
 /**
- * @struct Projectile
- * @brief Represents a single projectile, fired by either the player or an
- * enemy.
+ * @struct EntityHandle
+ * @brief A generation-tagged reference to an entity in a pool.
+ *
+ * Dense indices change whenever another entity is removed, so code that needs
+ * to remember an entity across ticks keeps a handle instead. A handle stops
+ * resolving as soon as its entity is released, even if the slot is reused.
+ */
+typedef struct {
+  Uint32 slot;        ///< The stable slot identifying the entity.
+  Uint32 generation;  ///< The slot's generation when the handle was taken.
+} EntityHandle;
+
+/// A handle that never resolves to an entity.
+#define ENTITY_HANDLE_NULL ((EntityHandle){0xFFFFFFFFu, 0})
+
+/**
+ * @struct EntitySlots
+ * @brief Maps stable slots to dense indices for one entity pool.
+ *
+ * Live entities always occupy dense indices `[0, count)`. Acquiring appends
+ * at `count`; releasing moves the last entity into the hole (swap-remove), so
+ * both are O(1) and every system iterates only live entities. All arrays hold
+ * `capacity` elements carved from the owning world's arena.
  */
 typedef struct {
-  float x;        ///< The X coordinate of the projectile's center.
-  float y;        ///< The Y coordinate of the projectile's center.
-  float dx;       ///< The velocity component on the X-axis.
-  float dy;       ///< The velocity component on the Y-axis.
-  int radius;     ///< The collision radius of the projectile.
-  bool active;    ///< Flag indicating if the projectile is currently in use.
-  bool is_enemy;  ///< Flag to distinguish between player and enemy projectiles.
-  SDL_Color color;  ///< The render color of the projectile.
-} Projectile;
+  Uint32* slot_of;     ///< Dense index -> slot.
+  Uint32* index_of;    ///< Slot -> dense index.
+  Uint32* generation;  ///< Per-slot generation, bumped on each release.
+  Uint32* free_slots;  ///< Stack of released slots.
+  int free_count;      ///< Number of entries on the free-slot stack.
+  int slots_used;      ///< Slots ever handed out; later ones are untouched.
+  int count;           ///< Number of live entities.
+  int capacity;        ///< Maximum number of live entities.
+  int dropped;  ///< Acquisitions refused because the pool was full.
+} EntitySlots;
 
 /**
- * @struct Enemy
- * @brief Represents a single enemy ship.
+ * @struct ProjectilePool
+ * @brief Stores every live projectile, fired by either the player or an
+ * enemy, densely packed in structure-of-arrays form.
+ *
+ * Each field lives in its own array so the per-tick integration and culling
+ * kernels stream only the data they touch, several entities per SIMD
+ * instruction. Hot per-tick data comes first; render-only data is kept apart
+ * at the end so it never shares cache lines with the simulation.
  */
 typedef struct {
-  float x;                ///< The X coordinate of the enemy's center.
-  float y;                ///< The Y coordinate of the enemy's center.
-  float dx;               ///< The velocity component on the X-axis.
-  float dy;               ///< The velocity component on the Y-axis.
-  int radius;             ///< The collision radius of the enemy.
-  bool active;            ///< Flag indicating if the enemy is currently in use.
-  Uint32 next_fire_time;  ///< AI timer: The next SDL_GetTicks() timestamp when
-                          ///< the enemy is allowed to fire.
-  Uint32
-      next_retarget_time;  ///< AI timer: The next SDL_GetTicks() timestamp to
-                           ///< recalculate its trajectory towards the player.
-} Enemy;
+  // Hot: read and written by the simulation every tick.
+  float* x;        ///< X coordinates of the centers.
+  float* y;        ///< Y coordinates of the centers.
+  float* dx;       ///< Velocities on the X-axis.
+  float* dy;       ///< Velocities on the Y-axis.
+  bool* is_enemy;  ///< Flags marking enemy-fired projectiles.
+  int radius;      ///< The collision radius shared by all projectiles.
+
+  // Cold: only read by the renderer, or when entities are added or removed.
+  float* prev_x;      ///< X coordinates at the end of the previous tick.
+  float* prev_y;      ///< Y coordinates at the end of the previous tick.
+  SDL_Color* color;   ///< The render colors of the projectiles.
+  EntitySlots slots;  ///< Dense index and handle bookkeeping.
+} ProjectilePool;
+
+/**
+ * @struct EnemyPool
+ * @brief Stores every live enemy ship, densely packed in structure-of-arrays
+ * form.
+ *
+ * Positions and velocities are integrated by the same SIMD kernel as
+ * projectiles. The AI timers are not stored here: they live in the world's
+ * timer wheel, keyed by each enemy's slot.
+ */
+typedef struct {
+  // Hot: read and written by the simulation every tick.
+  float* x;    ///< X coordinates of the centers.
+  float* y;    ///< Y coordinates of the centers.
+  float* dx;   ///< Velocities on the X-axis.
+  float* dy;   ///< Velocities on the Y-axis.
+  int radius;  ///< The collision radius shared by all enemies.
+
+  // Cold: only read by the renderer, or when enemies are added or removed.
+  float* prev_x;      ///< X coordinates at the end of the previous tick.
+  float* prev_y;      ///< Y coordinates at the end of the previous tick.
+  EntitySlots slots;  ///< Dense index and handle bookkeeping.
+} EnemyPool;
 
 #endif  // ENTITIES_H
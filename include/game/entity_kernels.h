@@ -0,0 +1,49 @@
+/**
+ * @file entity_kernels.h
+ * @brief Defines the SIMD kernels that update entity pools in bulk.
+ *
+ * The kernels operate on the structure-of-arrays pools from entities.h. SSE2
+ * is the baseline on x86; an AVX2 variant is selected at runtime when the CPU
+ * supports it, and a scalar fallback is used on every other architecture.
+ */
+
+#ifndef ENTITY_KERNELS_H
+#define ENTITY_KERNELS_H
+
+#include "utils/types.h"
+
+// --- Public API ---
+
+/**
+ * @brief Advances a range of entities by one step of their velocity.
+ * @param x The array of X coordinates to update in place.
+ * @param y The array of Y coordinates to update in place.
+ * @param dx The array of X velocities.
+ * @param dy The array of Y velocities.
+ * @param count The number of entities to process.
+ */
+void entity_kernels_integrate(float* x, float* y, const float* dx,
+                              const float* dy, int count);
+
+/**
+ * @brief Finds every entity whose center lies outside a rectangle.
+ *
+ * Entities exactly on an edge are kept, matching a strict `<`/`>` test. The
+ * kernel only reports the entities; removing them is left to the caller so
+ * the pool can be compacted afterwards.
+ * @param x The array of X coordinates.
+ * @param y The array of Y coordinates.
+ * @param count The number of entities to process.
+ * @param min_x The left edge of the keep rectangle.
+ * @param min_y The top edge of the keep rectangle.
+ * @param max_x The right edge of the keep rectangle.
+ * @param max_y The bottom edge of the keep rectangle.
+ * @param culled An array of at least `count` elements that receives the
+ * indices of the entities outside the rectangle, in ascending order.
+ * @return The number of indices written to `culled`.
+ */
+int entity_kernels_cull(const float* x, const float* y, int count,
+                        float min_x, float min_y, float max_x, float max_y,
+                        int* culled);
+
+#endif  // ENTITY_KERNELS_H
@@ -0,0 +1,117 @@
+/**
+ * @file entity_pools.h
+ * @brief Defines the allocation API for the dense entity pools.
+ *
+ * Every pool keeps its live entities packed at the front of its arrays.
+ * Acquiring and releasing entities are O(1), and generation-tagged handles
+ * allow an entity to be referenced safely across ticks.
+ */
+
+#ifndef ENTITY_POOLS_H
+#define ENTITY_POOLS_H
+
+#include "core/arena.h"
+#include "game/entities.h"
+
+// --- Projectile Pool ---
+
+/**
+ * @brief Carves an empty projectile pool out of an arena.
+ * @param pool A pointer to the ProjectilePool to initialize.
+ * @param arena The arena providing the pool's arrays. When the arena is only
+ * measuring, the pool is left without storage and must not be used.
+ * @param capacity The maximum number of live projectiles.
+ */
+void projectile_pool_init(ProjectilePool* pool, Arena* arena, int capacity);
+
+/**
+ * @brief Releases every live projectile, invalidating all their handles.
+ * @param pool A pointer to the ProjectilePool.
+ */
+void projectile_pool_clear(ProjectilePool* pool);
+
+/**
+ * @brief Reserves a new projectile at the end of the live range.
+ * @param pool A pointer to the ProjectilePool.
+ * @return The dense index of the new projectile, or -1 if the pool is full,
+ * in which case the pool's drop counter is incremented. The caller is
+ * responsible for initializing all of its fields.
+ */
+int projectile_pool_acquire(ProjectilePool* pool);
+
+/**
+ * @brief Removes a projectile by moving the last live projectile into its
+ * place.
+ *
+ * This invalidates the dense index of the moved projectile, so callers that
+ * release while iterating should walk the pool from the back.
+ * @param pool A pointer to the ProjectilePool.
+ * @param index The dense index of the projectile to remove.
+ */
+void projectile_pool_release(ProjectilePool* pool, int index);
+
+/**
+ * @brief Creates a handle that keeps referring to a projectile as it moves.
+ * @param pool A constant pointer to the ProjectilePool.
+ * @param index The dense index of a live projectile.
+ * @return A handle to the projectile.
+ */
+EntityHandle projectile_pool_handle(const ProjectilePool* pool, int index);
+
+/**
+ * @brief Looks up the current dense index of a projectile handle.
+ * @param pool A constant pointer to the ProjectilePool.
+ * @param handle A handle obtained from projectile_pool_handle().
+ * @return The dense index, or -1 if the projectile has been released.
+ */
+int projectile_pool_resolve(const ProjectilePool* pool, EntityHandle handle);
+
+// --- Enemy Pool ---
+
+/**
+ * @brief Carves an empty enemy pool out of an arena.
+ * @param pool A pointer to the EnemyPool to initialize.
+ * @param arena The arena providing the pool's arrays.
+ * @param capacity The maximum number of live enemies.
+ */
+void enemy_pool_init(EnemyPool* pool, Arena* arena, int capacity);
+
+/**
+ * @brief Releases every live enemy, invalidating all their handles.
+ * @param pool A pointer to the EnemyPool.
+ */
+void enemy_pool_clear(EnemyPool* pool);
+
+/**
+ * @brief Reserves a new enemy at the end of the live range.
+ * @param pool A pointer to the EnemyPool.
+ * @return The dense index of the new enemy, or -1 if the pool is full, in
+ * which case the pool's drop counter is incremented. The caller is
+ * responsible for initializing all of its fields.
+ */
+int enemy_pool_acquire(EnemyPool* pool);
+
+/**
+ * @brief Removes an enemy by moving the last live enemy into its place.
+ * @param pool A pointer to the EnemyPool.
+ * @param index The dense index of the enemy to remove.
+ */
+void enemy_pool_release(EnemyPool* pool, int index);
+
+/**
+ * @brief Creates a handle that keeps referring to an enemy as it moves.
+ * @param pool A constant pointer to the EnemyPool.
+ * @param index The dense index of a live enemy.
+ * @return A handle to the enemy.
+ */
+EntityHandle enemy_pool_handle(const EnemyPool* pool, int index);
+
+/**
+ * @brief Looks up the current dense index of an enemy handle.
+ * @param pool A constant pointer to the EnemyPool.
+ * @param handle A handle obtained from enemy_pool_handle().
+ * @return The dense index, or -1 if the enemy has been released.
+ */
+int enemy_pool_resolve(const EnemyPool* pool, EntityHandle handle);
+
+#endif  // ENTITY_POOLS_H
@@ -0,0 +1,91 @@
+/**
+ * @file game_events.h
+ * @brief Defines the gameplay events the world reports to the rest of the
+ * game.
+ *
+ * The simulation never plays sounds or changes the game state itself.
+ * Whatever it does that audio, rendering or telemetry may care about (a shot
+ * fired, an enemy destroyed, the player hit, the game lost) is appended to a
+ * preallocated event buffer instead. Whoever steps the world reads the
+ * buffer once the tick is over, reacts to its events and empties it before
+ * the next tick. Events are only ever pushed from the serial parts of a
+ * tick, so their order is the same on any number of threads.
+ */
+
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include "core/arena.h"
+#include "utils/types.h"
+
+/**
+ * @enum GameEventType
+ * @brief What happened in the world.
+ */
+typedef enum {
+  GAME_EVENT_PLAYER_SHOT,   ///< The player fired a projectile.
+  GAME_EVENT_ENEMY_SHOT,    ///< An enemy fired a projectile.
+  GAME_EVENT_ENEMY_KILLED,  ///< A player projectile destroyed an enemy.
+  GAME_EVENT_PLAYER_HIT,    ///< An enemy or enemy projectile hit the player.
+  GAME_EVENT_GAME_OVER,     ///< The player has no lives left.
+  GAME_EVENT_TYPE_COUNT     ///< Number of event types.
+} GameEventType;
+
+/**
+ * @struct GameEvent
+ * @brief One event and where in the world it happened.
+ */
+typedef struct {
+  GameEventType type;  ///< What happened.
+  float x;             ///< Logical X coordinate of the event.
+  float y;             ///< Logical Y coordinate of the event.
+} GameEvent;
+
+/**
+ * @struct GameEventBuffer
+ * @brief The events of the current tick, in the order they happened.
+ */
+typedef struct {
+  GameEvent* events;  ///< Preallocated event storage.
+  int count;          ///< Events pushed since the last clear.
+  int capacity;       ///< Size of the `events` array.
+  int dropped;        ///< Events lost because the buffer was full.
+} GameEventBuffer;
+
+// --- Public API ---
+
+/**
+ * @brief Carves the storage of an event buffer out of an arena.
+ * @param buffer A pointer to the GameEventBuffer to lay out.
+ * @param arena The arena to allocate from; may be a measuring arena.
+ * @param capacity The most events a single tick can push.
+ */
+void game_events_init(GameEventBuffer* buffer, Arena* arena, int capacity);
+
+/**
+ * @brief Empties the buffer, ready for the next tick.
+ * @param buffer A pointer to the GameEventBuffer to clear.
+ */
+void game_events_clear(GameEventBuffer* buffer);
+
+/**
+ * @brief Appends an event to the buffer.
+ *
+ * If the buffer is full the event is counted in `dropped` and discarded.
+ * @param buffer A pointer to the GameEventBuffer.
+ * @param type What happened.
+ * @param x The logical X coordinate of the event.
+ * @param y The logical Y coordinate of the event.
+ */
+void game_events_push(GameEventBuffer* buffer, GameEventType type, float x,
+                      float y);
+
+/**
+ * @brief Counts the buffered events of one type.
+ * @param buffer A constant pointer to the GameEventBuffer.
+ * @param type The event type to count.
+ * @return The number of events of that type since the last clear.
+ */
+int game_events_count(const GameEventBuffer* buffer, GameEventType type);
+
+#endif  // GAME_EVENTS_H
@@ -0,0 +1,81 @@
+/**
+ * @file hash_trace.h
+ * @brief Defines the file of per-tick world hashes used to check that a
+ * build still simulates exactly like a reference build.
+ *
+ * A reference build records world_hash() after every tick of a run, usually
+ * a replay, with `--record-hashes FILE`. A modified build runs the same
+ * replay with `--verify-hashes FILE` and reports the first tick whose hash
+ * differs, which is where the two builds started to behave differently.
+ */
+
+#ifndef HASH_TRACE_H
+#define HASH_TRACE_H
+
+#include <stdio.h>
+
+#include "utils/types.h"
+
+/**
+ * @struct HashTrace
+ * @brief An open hash file, either being recorded or being verified against.
+ */
+typedef struct {
+  FILE* file;     ///< The open file, or NULL when no hash file is open.
+  bool writing;   ///< True when recording, false when verifying.
+  bool diverged;  ///< True once a hash differed from the reference, or the
+                  ///< run outlasted it; later ticks are not compared.
+  Uint64 ticks;   ///< Ticks recorded or compared so far.
+} HashTrace;
+
+// --- Public API ---
+
+/**
+ * @brief Creates a hash file for recording.
+ * @param trace A pointer to the HashTrace to open.
+ * @param path The path of the file to create.
+ * @param seed The world seed, stored so mismatched runs are rejected.
+ * @return true on success, false if the file could not be created.
+ */
+bool hash_trace_create(HashTrace* trace, const char* path, Uint64 seed);
+
+/**
+ * @brief Opens a reference hash file for verification.
+ * @param trace A pointer to the HashTrace to open.
+ * @param path The path of the reference file.
+ * @param seed The world seed of this run, which must match the reference.
+ * @return true on success, false if the file is missing, invalid, or was
+ * recorded with another seed.
+ */
+bool hash_trace_open(HashTrace* trace, const char* path, Uint64 seed);
+
+/**
+ * @brief Appends the hash of one tick to a file being recorded.
+ * @param trace A pointer to the HashTrace being recorded.
+ * @param hash The world hash after the tick.
+ */
+void hash_trace_write(HashTrace* trace, Uint64 hash);
+
+/**
+ * @brief Compares the hash of one tick with the reference.
+ *
+ * The first mismatch is reported on stderr with its tick; after that, no
+ * more ticks are compared.
+ * @param trace A pointer to the HashTrace being verified against.
+ * @param hash The world hash after the tick.
+ * @param world_tick The world's own tick counter, included in the report.
+ * @return true if the hash matches, false once the run has diverged.
+ */
+bool hash_trace_verify(HashTrace* trace, Uint64 hash, Uint64 world_tick);
+
+/**
+ * @brief Closes the file and, when verifying, reports the result.
+ *
+ * Does nothing if the file is not open.
+ * @param trace A pointer to the HashTrace to close.
+ * @return false if verification failed or the run ended before the
+ * reference did, true otherwise.
+ */
+bool hash_trace_close(HashTrace* trace);
+
+#endif  // HASH_TRACE_H
@@ -0,0 +1,116 @@
+/**
+ * @file replay.h
+ * @brief Defines the per-tick input record and the replay file that stores a
+ * sequence of them.
+ *
+ * Because the world is deterministic, a replay only needs the settings that
+ * shape the simulation (seed, tick rate, pool capacities, spawn rate and AI
+ * budget) and, for every simulated tick, the movement keys held and whether
+ * and where the player fired. Feeding those back reproduces the recorded
+ * session exactly, in the game or in the headless runner.
+ *
+ * The file is written as the game runs and read back one tick at a time, so
+ * its length is unbounded. Each tick is stored as the change from the tick
+ * before: a run of up to 128 ticks without a change or a shot costs a single
+ * byte, and aim coordinates are stored as variable-length deltas.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdio.h>
+
+#include "game/world.h"
+#include "utils/types.h"
+
+/**
+ * @struct TickInput
+ * @brief The input that drives the world for one simulation tick.
+ */
+typedef struct {
+  Uint8 keys;  ///< Held movement keys, one bit per key (see replay.c).
+  bool fire;   ///< True if the player fires a projectile this tick.
+  int aim_x;   ///< Logical X coordinate the shot is aimed at.
+  int aim_y;   ///< Logical Y coordinate the shot is aimed at.
+} TickInput;
+
+/**
+ * @struct Replay
+ * @brief An open replay file, either being recorded or being played back.
+ */
+typedef struct {
+  FILE* file;          ///< The open file, or NULL when no replay is open.
+  bool writing;        ///< True when recording, false when playing back.
+  TickInput previous;  ///< The last tick written or read; the next one is
+                       ///< stored relative to it.
+  int run;             ///< Unchanged ticks not yet written (recording) or
+                       ///< still to be returned (playing back).
+  Uint64 ticks;        ///< Ticks written or read so far.
+} Replay;
+
+// --- Public API ---
+
+/**
+ * @brief Reads the movement keys from a keyboard state array.
+ *
+ * Only the keys field is set; fire and aim are left untouched.
+ * @param tick A pointer to the TickInput to fill.
+ * @param keyboard The keyboard state, indexed by SDL_Scancode.
+ */
+void tick_input_capture(TickInput* tick, const Uint8* keyboard);
+
+/**
+ * @brief Writes the movement keys of a tick into a keyboard state array, so
+ * it can be passed to world_update().
+ * @param tick A constant pointer to the TickInput to apply.
+ * @param keyboard The keyboard state to update, indexed by SDL_Scancode.
+ */
+void tick_input_apply(const TickInput* tick, Uint8* keyboard);
+
+/**
+ * @brief Creates a replay file and writes the settings that shape the world.
+ * @param replay A pointer to the Replay to open for recording.
+ * @param path The path of the file to create.
+ * @param config A constant pointer to the world settings of the session.
+ * @return true on success, false if the file could not be created.
+ */
+bool replay_create(Replay* replay, const char* path,
+                   const WorldConfig* config);
+
+/**
+ * @brief Opens a replay file for playback and applies its settings.
+ *
+ * The seed, tick rate, pool capacities, spawn rate and AI budget are replaced
+ * by the recorded ones; the collision mode is kept, so a replay can compare
+ * both algorithms.
+ * @param replay A pointer to the Replay to open for playback.
+ * @param path The path of the file to read.
+ * @param config A pointer to the world settings to update.
+ * @return true on success, false if the file is missing or not a replay.
+ */
+bool replay_open(Replay* replay, const char* path, WorldConfig* config);
+
+/**
+ * @brief Appends one tick to a replay being recorded.
+ * @param replay A pointer to the Replay being recorded.
+ * @param tick A constant pointer to the tick's input.
+ */
+void replay_write_tick(Replay* replay, const TickInput* tick);
+
+/**
+ * @brief Reads the next tick from a replay being played back.
+ * @param replay A pointer to the Replay being played back.
+ * @param tick A pointer that receives the tick's input.
+ * @return true if a tick was read, false at the end of the replay.
+ */
+bool replay_read_tick(Replay* replay, TickInput* tick);
+
+/**
+ * @brief Finishes writing any pending ticks and closes the file.
+ *
+ * Does nothing if the replay is not open.
+ * @param replay A pointer to the Replay to close.
+ */
+void replay_close(Replay* replay);
+
+#endif  // REPLAY_H
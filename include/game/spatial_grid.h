@@ -0,0 +1,110 @@
+/**
+ * @file spatial_grid.h
+ * @brief Defines a uniform-grid spatial hash used as a collision broadphase.
+ *
+ * The grid covers the logical play area and is rebuilt from scratch every
+ * tick. Entities outside the play area are clamped into the border cells, so
+ * every entity is always stored in exactly one cell and queries never miss an
+ * off-screen overlap.
+ */
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "core/arena.h"
+#include "utils/constants.h"
+#include "utils/types.h"
+
+/// Number of grid columns needed to cover the logical width.
+#define SPATIAL_GRID_COLS \
+  ((LOGICAL_WIDTH + COLLISION_GRID_CELL_SIZE - 1) / COLLISION_GRID_CELL_SIZE)
+/// Number of grid rows needed to cover the logical height.
+#define SPATIAL_GRID_ROWS \
+  ((LOGICAL_HEIGHT + COLLISION_GRID_CELL_SIZE - 1) / COLLISION_GRID_CELL_SIZE)
+/// Total number of cells in the grid.
+#define SPATIAL_GRID_CELLS (SPATIAL_GRID_COLS * SPATIAL_GRID_ROWS)
+
+/**
+ * @struct SpatialGrid
+ * @brief A counting-sort spatial hash mapping grid cells to entity indices.
+ *
+ * Items are first appended with spatial_grid_insert() and then bucketed by
+ * spatial_grid_finalize(). Within a cell, items keep their insertion order,
+ * which lets callers reproduce the ordering of a brute-force scan.
+ */
+typedef struct {
+  int cell_start[SPATIAL_GRID_CELLS + 1];  ///< Offset of each cell's items.
+  int* items;          ///< Entity indices, bucketed by cell.
+  int* pending_index;  ///< Inserted indices, unsorted.
+  int* pending_cell;   ///< Cell of each inserted index.
+  int count;           ///< Number of inserted items.
+  int capacity;        ///< Maximum number of items.
+} SpatialGrid;
+
+/**
+ * @struct SpatialGridRange
+ * @brief An inclusive rectangle of grid cells returned by a query.
+ */
+typedef struct {
+  int col_min;  ///< First column overlapped by the query.
+  int col_max;  ///< Last column overlapped by the query.
+  int row_min;  ///< First row overlapped by the query.
+  int row_max;  ///< Last row overlapped by the query.
+} SpatialGridRange;
+
+// --- Public API ---
+
+/**
+ * @brief Carves the item arrays of an empty grid out of an arena.
+ * @param grid A pointer to the SpatialGrid to initialize.
+ * @param arena The arena providing the item arrays.
+ * @param capacity The maximum number of items per rebuild.
+ */
+void spatial_grid_init(SpatialGrid* grid, Arena* arena, int capacity);
+
+/**
+ * @brief Removes all items from the grid in preparation for a rebuild.
+ * @param grid A pointer to the SpatialGrid to clear.
+ */
+void spatial_grid_clear(SpatialGrid* grid);
+
+/**
+ * @brief Appends an entity to the grid at the given position.
+ *
+ * Items inserted beyond the grid's capacity are ignored. The grid cannot be
+ * queried until spatial_grid_finalize() has been called.
+ * @param grid A pointer to the SpatialGrid.
+ * @param index The caller's index of the entity (e.g., its pool slot).
+ * @param x The X coordinate of the entity's center.
+ * @param y The Y coordinate of the entity's center.
+ */
+void spatial_grid_insert(SpatialGrid* grid, int index, float x, float y);
+
+/**
+ * @brief Buckets all inserted items by cell so the grid can be queried.
+ * @param grid A pointer to the SpatialGrid.
+ */
+void spatial_grid_finalize(SpatialGrid* grid);
+
+/**
+ * @brief Computes the range of cells overlapped by a circle.
+ * @param x The X coordinate of the circle's center.
+ * @param y The Y coordinate of the circle's center.
+ * @param radius The search radius, which must include the largest radius of
+ * any item stored in the grid.
+ * @return The inclusive range of cells to visit, clamped to the grid.
+ */
+SpatialGridRange spatial_grid_query(float x, float y, float radius);
+
+/**
+ * @brief Returns the items stored in a single cell.
+ * @param grid A constant pointer to a finalized SpatialGrid.
+ * @param col The column of the cell.
+ * @param row The row of the cell.
+ * @param count A pointer that receives the number of items in the cell.
+ * @return A pointer to the cell's entity indices, in insertion order.
+ */
+const int* spatial_grid_cell_items(const SpatialGrid* grid, int col, int row,
+                                   int* count);
+
+#endif  // SPATIAL_GRID_H
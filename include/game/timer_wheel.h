@@ -0,0 +1,90 @@
+/**
+ * @file timer_wheel.h
+ * @brief Defines a timer wheel that hands out the timers due on each tick.
+ *
+ * The wheel has one bucket per tick, and a power-of-two number of buckets
+ * spanning the longest delay it is created for, so a timer is filed straight
+ * into the bucket of its due tick and no timer ever needs to be re-sorted.
+ * Advancing the wheel to a tick appends that tick's bucket to a backlog of
+ * due timers, which the caller then pops as many of as it wants to handle.
+ * Timers left in the backlog stay due and come first on the next tick, so a
+ * burst of timers due on the same tick can be spread over several ticks.
+ *
+ * Timers are identified by caller-chosen indices from 0 to capacity - 1 and
+ * linked through intrusive lists, so scheduling, rescheduling and popping are
+ * all O(1) and the wheel never allocates after it is laid out.
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "core/arena.h"
+#include "utils/types.h"
+
+/**
+ * @struct TimerWheel
+ * @brief Buckets of pending timers, one per tick of the wheel's span.
+ */
+typedef struct {
+  int* next;         ///< Next timer in the same list, or -1.
+  int* prev;         ///< Previous timer in the same list, or -1.
+  int* list;         ///< List each timer is filed in, or -1 when idle.
+  Uint64* due_tick;  ///< Tick each timer was last scheduled for.
+  Uint32* tag;       ///< Caller value stored with each timer.
+  int* heads;        ///< First timer of each bucket, then of the backlog.
+  int* tails;        ///< Last timer of each bucket, then of the backlog.
+  int bucket_count;  ///< Buckets in the wheel; a power of two.
+  int capacity;      ///< Number of timers.
+} TimerWheel;
+
+// --- Public API ---
+
+/**
+ * @brief Carves the arrays of a timer wheel out of an arena; every timer
+ * starts idle.
+ * @param wheel A pointer to the TimerWheel to lay out.
+ * @param arena The arena to allocate from; may be a measuring arena.
+ * @param capacity The number of timers.
+ * @param max_delay The longest delay, in ticks, a timer will be scheduled
+ * with.
+ */
+void timer_wheel_init(TimerWheel* wheel, Arena* arena, int capacity,
+                      int max_delay);
+
+/**
+ * @brief Makes every timer idle, including the due ones in the backlog.
+ *
+ * Costs O(buckets + pending timers), independent of the capacity.
+ * @param wheel A pointer to the TimerWheel to clear.
+ */
+void timer_wheel_clear(TimerWheel* wheel);
+
+/**
+ * @brief Schedules a timer, replacing any pending schedule it had.
+ * @param wheel A pointer to the TimerWheel.
+ * @param timer The index of the timer.
+ * @param due_tick The tick it is due on; after the last tick the wheel was
+ * advanced to, and no further than the wheel's maximum delay.
+ * @param tag A value to store with the timer, e.g. to detect that the
+ * timer's owner has since been destroyed.
+ */
+void timer_wheel_schedule(TimerWheel* wheel, int timer, Uint64 due_tick,
+                          Uint32 tag);
+
+/**
+ * @brief Moves the timers due on a tick to the end of the backlog.
+ *
+ * Must be called for every tick in turn.
+ * @param wheel A pointer to the TimerWheel.
+ * @param tick The tick that has just been reached.
+ */
+void timer_wheel_advance(TimerWheel* wheel, Uint64 tick);
+
+/**
+ * @brief Takes the oldest timer out of the backlog; it becomes idle.
+ * @param wheel A pointer to the TimerWheel.
+ * @return The index of the timer, or -1 if no timer is due.
+ */
+int timer_wheel_pop(TimerWheel* wheel);
+
+#endif  // TIMER_WHEEL_H
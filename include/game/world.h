@@ -10,11 +10,71 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include "core/arena.h"
+#include "core/frame_arena.h"
+#include "core/thread_pool.h"
 #include "entities.h"
+#include "game/game_events.h"
+#include "game/spatial_grid.h"
+#include "game/timer_wheel.h"
+#include "utils/rng.h"
 #include "utils/types.h"
 
 // --- Main World Structure ---
 
+/**
+ * @enum CollisionMode
+ * @brief Selects the algorithm used to find colliding entity pairs.
+ *
+ * Both modes produce identical results; the brute-force path is kept so the
+ * two can be compared for correctness and timing.
+ */
+typedef enum {
+  COLLISION_MODE_GRID,        ///< Uniform-grid spatial hash broadphase.
+  COLLISION_MODE_BRUTE_FORCE  ///< Test every enemy against every projectile.
+} CollisionMode;
+
+/**
+ * @struct WorldConfig
+ * @brief Startup settings that size and tune a World.
+ */
+typedef struct {
+  int max_projectiles;           ///< Capacity of the projectile pool.
+  int max_enemies;               ///< Capacity of the enemy pool.
+  CollisionMode collision_mode;  ///< Collision algorithm to use.
+  Uint64 seed;                   ///< Seed of the world's random generator.
+  int tick_rate;                 ///< Simulation ticks per second.
+  float enemy_spawn_rate;        ///< Enemies spawned per reference tick.
+  int ai_event_budget;           ///< AI timers handled per tick; 0 for no
+                                 ///< limit.
+} WorldConfig;
+
+/**
+ * @enum EnemyTimer
+ * @brief The AI timers every enemy has in the world's timer wheel.
+ *
+ * The timer of kind `k` for the enemy in slot `s` has the index
+ * `s * ENEMY_TIMER_COUNT + k`.
+ */
+typedef enum {
+  ENEMY_TIMER_FIRE,      ///< The enemy fires at the player.
+  ENEMY_TIMER_RETARGET,  ///< The enemy re-aims its course at the player.
+  ENEMY_TIMER_COUNT      ///< Number of timers per enemy.
+} EnemyTimer;
+
+/**
+ * @struct ChunkLists
+ * @brief Entity indices collected by a parallel pass, one list per chunk.
+ *
+ * The chunk starting at entity `begin` writes its list from `items + begin`,
+ * so chunks never share memory. A serial step then reads the lists in chunk
+ * order, which is the order a serial loop would have produced.
+ */
+typedef struct {
+  int* items;   ///< One slot per entity of the pool.
+  int* counts;  ///< Length of each chunk's list.
+} ChunkLists;
+
 /**
  * @struct World
  * @brief Contains the entire gameplay state, including all entities and game
@@ -22,68 +82,189 @@
  *
  * This struct acts as a container for the player, pools of enemies and
  * projectiles, and gameplay-related data like the score and difficulty scaling.
+ * All pool and scratch arrays are carved from a single aligned arena sized
+ * once in world_init(), so resetting the world never touches the allocator.
+ *
+ * The world never reads the wall clock or the global `rand()`: timers count
+ * simulation ticks and all randomness comes from the world's own generator,
+ * so the same seed and the same inputs always produce the same game.
+ *
+ * Enemy AI is event driven: each enemy's fire and retarget timers sit in a
+ * timer wheel, and a tick only visits the enemies whose timers are due, at
+ * most `ai_event_budget` of them. Due timers beyond the budget wait for the
+ * next tick, so a burst of timers is spread over several ticks.
+ *
+ * The per-entity work of a tick (integration and the collision narrowphase)
+ * can be spread over a thread pool. Parallel passes only write
+ * to the entities of their own chunk; everything with side effects (random
+ * draws, spawns, releases, score, lives and events) happens afterwards in a
+ * serial merge that visits entities in index order. The outcome is therefore
+ * identical for any number of threads.
+ *
+ * The world has no audio or game-state dependencies: everything the rest of
+ * the game reacts to is reported through the `events` buffer, which the
+ * caller reads and clears after each tick.
  */
 typedef struct {
-  Player player;                            ///< The player entity.
-  Projectile projectiles[MAX_PROJECTILES];  ///< Pool of all projectiles.
-  Enemy enemies[MAX_ENEMIES];               ///< Pool of all enemies.
-  int score;                                ///< The player's current score.
-  float enemy_speed_multiplier;  ///< Current speed modifier for enemies.
+  Player player;                   ///< The player entity.
+  ProjectilePool projectiles;      ///< Pool of all projectiles.
+  EnemyPool enemies;               ///< Pool of all enemies.
+  int score;                       ///< The player's current score.
+  float enemy_speed_multiplier;    ///< Current speed modifier for enemies.
+  float enemy_spawn_rate;          ///< Enemies spawned per reference tick.
+  Uint64 tick;                     ///< Simulation ticks since the last reset.
+  int tick_rate;                   ///< Simulation ticks per second.
+  float tick_scale;  ///< SIM_REFERENCE_RATE / tick_rate; scales per-tick
+                     ///< speeds and chances so gameplay runs at the same
+                     ///< real-time pace at any tick rate.
+  Uint64 seed;                     ///< The seed the generator started from.
+  Rng rng;                         ///< Source of all gameplay randomness.
+  CollisionMode collision_mode;    ///< Collision algorithm; kept across resets.
+  SpatialGrid projectile_grid;     ///< Broadphase grid, rebuilt every tick.
+  bool* projectile_consumed;       ///< Collision scratch: flags projectiles
+                                   ///< destroyed this tick.
+  ChunkLists culled_projectiles;   ///< Projectiles leaving the screen.
+  TimerWheel enemy_timers;         ///< AI timers of every enemy slot.
+  int ai_event_budget;             ///< AI timers handled per tick, or 0.
+  int* retargeting_enemies;        ///< AI scratch: enemies re-aiming now,
+                                   ///< when there is no frame arena.
+  int* firing_enemies;             ///< AI scratch: enemies firing now, when
+                                   ///< there is no frame arena.
+  int* enemy_hits;                 ///< Collision scratch: what each enemy
+                                   ///< hit, when there is no frame arena.
+  GameEventBuffer events;          ///< Events of the current tick.
+  ThreadPool* thread_pool;         ///< Workers for the parallel passes, or
+                                   ///< NULL to run them all on the caller.
+  FrameArena* frame_arena;         ///< Per-tick scratch lists, or NULL to
+                                   ///< use the scratch arrays above.
+  Arena arena;                     ///< Owns the memory behind every array.
 } World;
 
 // --- Public API ---
 
 // Lifecycle
 /**
- * @brief Initializes the world state for the very first time.
+ * @brief Fills a WorldConfig with the default pool sizes and settings.
+ * @param config A pointer to the WorldConfig to fill.
+ */
+void world_config_init(WorldConfig* config);
+
+/**
+ * @brief Allocates the world's arena and initializes the world state for the
+ * very first time.
  * @param world A pointer to the World struct to initialize.
+ * @param config A constant pointer to the settings sizing the world.
+ * @return true on success, false if the arena could not be allocated.
+ */
+bool world_init(World* world, const WorldConfig* config);
+
+/**
+ * @brief Frees the memory owned by the world.
+ * @param world A pointer to the World struct to destroy.
  */
-void world_init(World* world);
+void world_destroy(World* world);
 
 /**
  * @brief Resets the world state to its initial configuration for a new game
  * session.
+ *
+ * The simulation clock restarts at zero, but the random generator is not
+ * reseeded, so consecutive sessions differ while a whole run remains
+ * reproducible from the seed given to world_init().
  * @param world A pointer to the World struct to reset.
  */
 void world_reset(World* world);
 
+/**
+ * @brief Lets the world run its parallel passes on a thread pool.
+ * @param world A pointer to the World struct.
+ * @param pool A pointer to a started ThreadPool that outlives the world's
+ * use of it, or NULL to run everything on the calling thread.
+ */
+void world_set_thread_pool(World* world, ThreadPool* pool);
+
+/**
+ * @brief Lets the world take its per-tick scratch lists from a frame arena.
+ *
+ * Each pass hands its lists back before it returns, so any number of ticks
+ * can run between two calls of frame_arena_begin().
+ * @param world A pointer to the World struct.
+ * @param arena A pointer to a FrameArena that outlives the world's use of
+ * it, or NULL to use the scratch arrays in the world's own arena.
+ */
+void world_set_frame_arena(World* world, FrameArena* arena);
+
+/**
+ * @brief Marks the start of a pass that takes scratch memory.
+ * @param world A constant pointer to the World struct.
+ * @return The mark to pass to world_scratch_rewind() when the pass ends.
+ */
+size_t world_scratch_mark(const World* world);
+
+/**
+ * @brief Gets scratch memory that lasts until the pass that took it ends.
+ * @param world A pointer to the World struct.
+ * @param size The number of bytes requested.
+ * @param fallback Memory of at least `size` bytes to use when the world has
+ * no frame arena or it is full.
+ * @return A pointer to the memory, aligned to ARENA_DEFAULT_ALIGNMENT.
+ */
+void* world_scratch(World* world, size_t size, void* fallback);
+
+/**
+ * @brief Ends a pass, handing back the scratch memory taken since its mark.
+ * @param world A pointer to the World struct.
+ * @param mark The value world_scratch_mark() returned when the pass began.
+ */
+void world_scratch_rewind(World* world, size_t mark);
+
 // Core Logic
 /**
- * @brief Updates all entities and game logic for a single frame.
+ * @brief Advances the simulation clock by one tick and updates all entities
+ * and game logic.
  * @param world A pointer to the World struct.
  * @param input A constant pointer to the current input state for player
  * movement.
- * @param audio A pointer to the audio context for playing sounds.
  */
-void world_update(World* world, const InputState* input, AudioContext* audio);
+void world_update(World* world, const InputState* input);
 
 // Spawning
 /**
  * @brief Creates a new player projectile originating from the player and aimed
- * at the mouse cursor.
+ * at a point.
+ *
+ * The target is given in whole logical pixels, the same form in which it is
+ * stored in a replay, so live and replayed shots fly identically.
  * @param world A pointer to the World struct.
- * @param renderer A pointer to the renderer context for coordinate conversion.
- * @param mouse_x The current window X coordinate of the mouse.
- * @param mouse_y The current window Y coordinate of the mouse.
- * @param audio A pointer to the audio context to play the firing sound.
+ * @param target_x The logical X coordinate to aim at.
+ * @param target_y The logical Y coordinate to aim at.
  */
-void world_fire_player_projectile(World* world, RendererContext* renderer,
-                                  int mouse_x, int mouse_y,
-                                  AudioContext* audio);
+void world_fire_player_projectile(World* world, int target_x, int target_y);
 
 // Collisions
 /**
  * @brief Checks and handles all collisions between game entities.
  *
  * This function orchestrates all collision checks (player vs. enemy,
- * projectiles vs. entities) and updates the game state accordingly.
- * It is implemented in `world_collisions.c`.
+ * projectiles vs. entities) and applies their effects on lives and score.
+ * Every hit is reported as an event, followed by GAME_EVENT_GAME_OVER if the
+ * player has no lives left. It is implemented in `world_collisions.c`.
  * @param world A pointer to the World struct.
- * @param audio A pointer to the audio context for playing explosion sounds.
- * @param current_state A pointer to the main game state, which will be set to
- * GAME_STATE_GAME_OVER if the player's lives reach zero.
  */
-void world_check_collisions(World* world, AudioContext* audio,
-                            GameStateEnum* current_state);
+void world_check_collisions(World* world);
+
+// Validation
+/**
+ * @brief Computes a 64-bit hash of the simulation state.
+ *
+ * Covers everything a tick can change: the clock, score and difficulty, the
+ * random generator, the player, and every live projectile and enemy in pool
+ * order. Render-only data (previous positions, colors) is left out. Two
+ * builds that agree on this hash after every tick behave identically.
+ * It is implemented in `world_hash.c`.
+ * @param world A constant pointer to the World struct.
+ * @return The hash of the world's current state.
+ */
+Uint64 world_hash(const World* world);
 
 #endif  // WORLD_H
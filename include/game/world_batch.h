@@ -0,0 +1,87 @@
+/**
+ * @file world_batch.h
+ * @brief Defines a batch of independent worlds played by bots, for balance
+ * tuning and AI experiments.
+ *
+ * World i of a batch is seeded with the base seed plus i and plays a single
+ * game: until the player loses its last life or the tick limit is reached.
+ * Worlds share no state, so the batch hands whole worlds to the thread pool.
+ * One thread steps a world from its first tick to its last, keeping the
+ * world's pools in that core's cache; threads that run out of worlds steal
+ * the ones that have not started yet.
+ */
+
+#ifndef WORLD_BATCH_H
+#define WORLD_BATCH_H
+
+#include "core/thread_pool.h"
+#include "game/bot.h"
+#include "game/world.h"
+#include "utils/types.h"
+
+/**
+ * @struct WorldBatchResult
+ * @brief How the game in one world of a batch ended.
+ */
+typedef struct {
+  Uint64 seed;            ///< Seed the world was created with.
+  int score;              ///< Score at the end of the game.
+  Uint64 survival_ticks;  ///< Ticks played until the game ended.
+  bool survived;          ///< True if the tick limit ended the game.
+} WorldBatchResult;
+
+/**
+ * @struct WorldBatchEntry
+ * @brief One world of a batch with the state its bot needs.
+ */
+typedef struct {
+  World world;                        ///< The simulated world.
+  Uint8 keyboard[SDL_NUM_SCANCODES];  ///< Keys the bot holds this tick.
+  WorldBatchResult result;            ///< Filled in by world_batch_run().
+} WorldBatchEntry;
+
+/**
+ * @struct WorldBatch
+ * @brief A set of worlds that are stepped together.
+ */
+typedef struct {
+  WorldBatchEntry* entries;  ///< One entry per world.
+  int count;                 ///< Number of worlds.
+  BotKind bot;               ///< The bot playing every world.
+  Uint64 max_ticks;          ///< Tick limit of the current run.
+} WorldBatch;
+
+// --- Public API ---
+
+/**
+ * @brief Creates the worlds of a batch.
+ * @param batch A pointer to the WorldBatch to initialize.
+ * @param config A constant pointer to the settings every world is created
+ * with; world i uses `config->seed + i` as its seed.
+ * @param count The number of worlds.
+ * @param bot The bot playing every world.
+ * @return true on success, false if memory for the worlds ran out.
+ */
+bool world_batch_init(WorldBatch* batch, const WorldConfig* config, int count,
+                      BotKind bot);
+
+/**
+ * @brief Plays one game in every world and records the results.
+ *
+ * The results depend only on the settings, the seeds and the bot, never on
+ * the number of threads. Calling it again plays a new game in every world,
+ * continuing from each world's random state.
+ * @param batch A pointer to the initialized WorldBatch.
+ * @param pool A pointer to the ThreadPool to run on, or NULL to run the
+ * worlds one after another on the calling thread.
+ * @param max_ticks The number of ticks after which a game is stopped.
+ */
+void world_batch_run(WorldBatch* batch, ThreadPool* pool, Uint64 max_ticks);
+
+/**
+ * @brief Frees every world of a batch.
+ * @param batch A pointer to the WorldBatch to destroy.
+ */
+void world_batch_destroy(WorldBatch* batch);
+
+#endif  // WORLD_BATCH_H
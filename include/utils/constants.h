@@ -14,19 +14,108 @@
 #define WINDOW_TITLE "Starfall 2D"  // The title displayed on the game window.
 #define LOGICAL_WIDTH 1280          // The fixed internal horizontal resolution.
 #define LOGICAL_HEIGHT 720          // The fixed internal vertical resolution.
-#define FPS_TARGET 60  // The target frames per second for the game loop.
-#define FRAME_DELAY (1000 / FPS_TARGET)  // The delay in ms to achieve the FPS.
-#define FONT_SIZE_NORMAL 24              // Default font size for UI elements.
+#define FONT_SIZE_NORMAL 24  // Default font size for UI elements.
 #define FONT_SIZE_LARGE 48  // Font size for titles (e.g., "Game Over").
 #define FONT_SIZE_SMALL 16  // Font size for secondary text (e.g., hints).
+#define MAX_PATH_LENGTH 256  // Longest file path accepted in settings.
+#define MAX_CONFIG_DEPTH 8   // Config files nested through `config = FILE`.
+
+// Asset Constants
+#define ASSET_PACK_PATH \
+  "assets/starfall.pak"  // Packed archive; loose files are used without it.
+#define FONT_PATH "assets/fonts/Gameplay.ttf"  // The UI font.
+#define BACKGROUND_IMAGE_PATH \
+  "assets/images/background.jpg"  // The starfield behind the game.
+#define MUSIC_PATH "assets/sounds/background.mp3"  // The looping music.
+#define ASSET_NAME_LENGTH 64       // Longest asset name in an archive.
+#define ASSET_PACK_MAX_ENTRIES 32  // Entries an archive may hold.
+#define ASSET_PACK_ALIGNMENT \
+  64  // Alignment (bytes) of each entry's data within the archive.
+
+// Text Rendering Constants
+#define GLYPH_ATLAS_WIDTH 512  // Width (px) of each font's glyph atlas.
+#define GLYPH_ATLAS_PADDING \
+  1  // Empty pixels between glyphs, so filtering never bleeds into
+     // a neighbor.
+#define TEXT_BATCH_GLYPHS \
+  64  // Glyphs submitted per draw call; longer strings use several.
+
+// Entity Rendering Constants
+#define RENDER_BATCH_QUADS \
+  4096  // Entity quads submitted per draw call; more use several calls.
+
+// Frame Memory Constants
+#define FRAME_ARENA_BYTES \
+  262144  // Scratch memory (bytes) each frame can use; two are kept.
+
+// Profiler Constants (only used when built with PROFILE=1)
+#define PROFILER_HISTORY_FRAMES \
+  600  // Frames kept for the overlay statistics and the CSV.
+#define PROFILER_CSV_PATH \
+  "starfall_profile.csv"  // File the frame history is written to at exit.
+
+// Allocation Check Constants (only used with --alloc-check)
+#define ALLOC_CHECK_WARMUP \
+  120  // Frames (or simulation ticks) allowed to allocate once loaded.
+#define ALLOC_CHECK_MAX_REPORTS \
+  10  // Allocating frames printed; later ones are only counted.
+
+// Tracer Constants (only used with --trace)
+#define TRACE_BUFFER_EVENTS \
+  1048576  // Events kept per run (32 bytes each); later ones are dropped.
+
+// Audio Constants
+#define AUDIO_SAMPLE_RATE 44100  // Output sample rate (Hz).
+#define AUDIO_BUFFER_FRAMES \
+  2048  // Default sample frames per audio device callback.
+#define AUDIO_MIN_BUFFER_FRAMES 256   // Smallest buffer for --audio-buffer.
+#define AUDIO_MAX_BUFFER_FRAMES 4096  // Largest buffer for --audio-buffer.
+#define AUDIO_LOW_LATENCY_FRAMES \
+  256  // Buffer the adaptive mode starts with; grown on underruns.
+#define AUDIO_UNDERRUN_FACTOR \
+  2  // Callback gap, in buffer lengths, that counts as an underrun.
+#define AUDIO_UNDERRUNS_TO_GROW \
+  2  // Underruns within one window that double the adaptive buffer.
+#define AUDIO_UNDERRUN_WINDOW_MS \
+  2000  // Window (ms) underruns are counted over before being forgotten.
+#define AUDIO_SHRINK_DELAY_MS \
+  10000  // Time (ms) without underruns before the buffer is halved again.
+#define AUDIO_MAX_SHRINK_DELAY_MS \
+  300000  // Cap of the shrink delay, which doubles after every grow.
+#define DEFAULT_AUDIO_VOICES 16  // Default mixer channels for sound effects.
+#define MAX_AUDIO_VOICES 64      // Upper bound for --voices.
+#define SFX_MAX_SOUNDS 16        // Sound effects the software mixer can hold.
+#define SFX_MAX_VOICES \
+  512  // Voices the software mixer plays at once; more steal the oldest.
+#define SFX_COMMAND_RING \
+  1024  // Play commands queued for the audio thread; a power of two.
+#define SFX_MIX_BLOCK_FRAMES \
+  256  // Frames summed per pass of the software mixer's accumulator.
+
+// Parallel Simulation Constants
+#define THREAD_POOL_MAX_THREADS 64  // Upper bound for --threads.
+#define PARALLEL_CHUNK_ENTITIES \
+  1024  // Entities per chunk of a parallel pass; smaller pools run serially.
+
+// Simulation Clock Constants
+#define SIM_REFERENCE_RATE \
+  60  // Tick rate (Hz) the per-tick speeds below are tuned for.
+#define DEFAULT_SIM_RATE 60  // Default simulation ticks per second.
+#define MIN_SIM_RATE 10      // Lowest tick rate accepted at startup.
+#define MAX_SIM_RATE 1000    // Highest tick rate accepted at startup.
+#define MAX_TICKS_PER_FRAME \
+  8  // Ticks a single frame may run before the backlog is dropped.
+#define MS_TO_TICKS(ms, rate) \
+  (((ms) * (rate) + 999) / 1000)  // Converts a delay to whole ticks.
 
 // Player Constants
 #define PLAYER_START_LIVES 5  // The number of lives the player starts with.
 #define PLAYER_RADIUS 12      // The collision radius of the player's ship.
-#define PLAYER_SPEED 5.0f  // The movement speed of the player in pixels/frame.
+#define PLAYER_SPEED 5.0f  // Player speed in pixels per reference tick.
 
 // Projectile Constants
-#define MAX_PROJECTILES 200     // The maximum number of concurrent projectiles.
+#define DEFAULT_MAX_PROJECTILES \
+  200  // Default capacity of the projectile pool.
 #define PROJECTILE_SPEED 16.0f  // The speed of player-fired projectiles.
 #define PROJECTILE_RADIUS 4     // The collision radius for projectiles.
 #define ENEMY_PROJECTILE_SPEED 4.0f  // The speed of enemy-fired projectiles.
@@ -35,10 +124,13 @@
       // projectile is destroyed.
 
 // Enemy Constants
-#define MAX_ENEMIES 50   // The maximum number of concurrent enemies.
+#define DEFAULT_MAX_ENEMIES 50  // Default capacity of the enemy pool.
 #define ENEMY_RADIUS 12  // The collision radius for enemies.
 #define ENEMY_SPAWN_RATE \
-  0.03f  // The chance (0.0 to 1.0) to spawn an enemy each frame.
+  0.03f  // Default enemies spawned per reference tick; below 1 it is the
+         // chance of a single spawn.
+#define MAX_ENEMY_SPAWN_RATE \
+  1000.0f  // Highest spawn rate accepted at startup (for stress tests).
 #define ENEMY_SPAWN_OFFSET \
   20  // Distance from the screen edge where enemies appear.
 #define ENEMY_DESTROY_OFFSET \
@@ -50,5 +142,25 @@
   4000  // Maximum delay (ms) between enemy shots.
 #define ENEMY_RETARGET_COOLDOWN_MIN 2000  // Minimum delay (ms) for re-aiming.
 #define ENEMY_RETARGET_COOLDOWN_MAX 5000  // Maximum delay (ms) for re-aiming.
+#define ENEMY_AI_EVENT_BUDGET \
+  256  // Default AI timers handled per tick; later ones wait a tick.
+
+// Entity Pool Constants
+#define MAX_POOL_CAPACITY \
+  1000000  // Upper bound for any pool capacity set at startup.
+
+// Collision Constants
+#define COLLISION_GRID_CELL_SIZE \
+  64  // Side length (px) of a broadphase grid cell.
+
+// Bot Constants
+#define BOT_MOVE_PERIOD 90  // Ticks the scripted bot holds each direction.
+#define BOT_FIRE_PERIOD 8   // Ticks between bot shots.
+#define BOT_DANGER_RADIUS \
+  150.0f  // Distance (px) within which the evasive bot avoids threats.
+#define BOT_CENTER_PULL \
+  0.00002f  // Strength of the evasive bot's pull toward the screen center.
+#define BOT_STEER_DEADZONE \
+  0.002f  // Smallest steering push that makes the evasive bot move.
 
 #endif  // CONSTANTS_H
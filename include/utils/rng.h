@@ -0,0 +1,91 @@
+/**
+ * @file rng.h
+ * @brief Defines a small, fast, seedable pseudo-random number generator.
+ *
+ * The generator is xoshiro128** (Blackman & Vigna), seeded by expanding a
+ * 64-bit seed with SplitMix64. Each World owns its own instance, so the same
+ * seed always produces the same sequence regardless of the platform's
+ * `rand()` implementation or what other code draws numbers.
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @struct Rng
+ * @brief The state of a xoshiro128** generator.
+ */
+typedef struct {
+  Uint32 state[4];  ///< Generator state; never all zero once seeded.
+} Rng;
+
+/**
+ * @brief Advances a SplitMix64 sequence, used to expand a seed.
+ * @param x A pointer to the SplitMix64 state.
+ * @return The next 64-bit output.
+ */
+static inline Uint64 rng_splitmix64(Uint64* x) {
+  Uint64 z = (*x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Seeds a generator. Any seed, including zero, is valid.
+ * @param rng A pointer to the generator to seed.
+ * @param seed The seed value.
+ */
+static inline void rng_seed(Rng* rng, Uint64 seed) {
+  Uint64 a = rng_splitmix64(&seed);
+  Uint64 b = rng_splitmix64(&seed);
+  rng->state[0] = (Uint32)a;
+  rng->state[1] = (Uint32)(a >> 32);
+  rng->state[2] = (Uint32)b;
+  rng->state[3] = (Uint32)(b >> 32);
+}
+
+/**
+ * @brief Returns the next 32 random bits.
+ * @param rng A pointer to the generator.
+ * @return A uniformly distributed 32-bit value.
+ */
+static inline Uint32 rng_next(Rng* rng) {
+  Uint32* s = rng->state;
+  Uint32 x = s[1] * 5;
+  Uint32 result = ((x << 7) | (x >> 25)) * 9;
+  Uint32 t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = (s[3] << 11) | (s[3] >> 21);
+  return result;
+}
+
+/**
+ * @brief Returns a random float in [0, 1).
+ * @param rng A pointer to the generator.
+ * @return A uniformly distributed float with 24 bits of precision.
+ */
+static inline float rng_float(Rng* rng) {
+  return (float)(rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Returns a random integer in [0, bound).
+ *
+ * Uses a multiply-shift instead of `%`, which avoids a division and the
+ * strongest modulo bias for small bounds.
+ * @param rng A pointer to the generator.
+ * @param bound The exclusive upper bound; must be positive.
+ * @return A random integer from 0 to bound - 1.
+ */
+static inline int rng_range(Rng* rng, int bound) {
+  return (int)(((Uint64)rng_next(rng) * (Uint32)bound) >> 32);
+}
+
+#endif  // RNG_H
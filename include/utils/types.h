@@ -12,16 +12,51 @@
 #include <SDL2/SDL_ttf.h>
 #include <stdbool.h>
 
+#include "utils/constants.h"
+
 /**
  * @enum GameStateEnum
  * @brief Represents the main states or scenes of the game application.
  */
 typedef enum {
+  GAME_STATE_LOADING,   ///< The fonts are loading; a progress bar shows.
   GAME_STATE_MENU,      ///< The main menu is active.
   GAME_STATE_PLAYING,   ///< The main gameplay is active.
   GAME_STATE_GAME_OVER  ///< The game over screen is active.
 } GameStateEnum;
 
+/// First character stored in a glyph atlas (space).
+#define GLYPH_ATLAS_FIRST 32
+/// Number of characters stored in a glyph atlas (printable ASCII).
+#define GLYPH_ATLAS_COUNT 95
+
+/**
+ * @struct Glyph
+ * @brief Locates one pre-rendered character inside a glyph atlas.
+ */
+typedef struct {
+  SDL_Rect source;  ///< The glyph's pixels within the atlas texture.
+  int advance;      ///< Horizontal distance to the next character's origin.
+} Glyph;
+
+/**
+ * @struct GlyphAtlas
+ * @brief Every printable ASCII character of one font, rendered once into a
+ * single texture.
+ *
+ * Glyphs are rendered in white so any text color can be applied through the
+ * vertex colors at draw time.
+ */
+typedef struct {
+  SDL_Texture* texture;             ///< The texture holding every glyph.
+  Glyph glyphs[GLYPH_ATLAS_COUNT];  ///< Per-character atlas locations.
+  /// Kerning adjustment for each pair of characters, indexed [left][right].
+  Sint8 kerning[GLYPH_ATLAS_COUNT][GLYPH_ATLAS_COUNT];
+  float texture_w;  ///< Atlas width, for texture coordinates.
+  float texture_h;  ///< Atlas height, for texture coordinates.
+  int line_height;  ///< The font's line height in pixels.
+} GlyphAtlas;
+
 /**
  * @struct RendererContext
  * @brief Holds all SDL-related rendering resources and state.
@@ -32,21 +67,101 @@ typedef struct {
   TTF_Font* font_normal;            ///< The normal font for UI text.
   TTF_Font* font_large;             ///< The large font for titles.
   TTF_Font* font_small;             ///< The small font for secondary text.
+  GlyphAtlas atlas_normal;          ///< Pre-rendered glyphs of font_normal.
+  GlyphAtlas atlas_large;           ///< Pre-rendered glyphs of font_large.
+  GlyphAtlas atlas_small;           ///< Pre-rendered glyphs of font_small.
   SDL_Texture* background_texture;  ///< Cached background texture.
   SDL_Texture* game_texture;  ///< The render target for the logical scene.
   SDL_Rect viewport;          ///< The calculated viewport for scaled rendering.
   bool is_fullscreen;         ///< Current fullscreen state flag.
+  SDL_Vertex* batch_vertices;  ///< Queued entity quads, four vertices each.
+  int* batch_indices;   ///< Constant two-triangle index pattern per quad.
+  int batch_quads;      ///< Number of quads currently queued.
+  int draw_calls;       ///< Draw calls issued so far in the current frame.
+  int last_draw_calls;  ///< Draw calls issued by the last presented frame.
+  bool show_debug;      ///< True to draw the debug overlay (toggled by F3).
+  struct FrameArena* frame_arena;  ///< Scratch memory for the current frame.
 } RendererContext;
 
+/**
+ * @enum SoundId
+ * @brief The sound effects of the game.
+ */
+typedef enum {
+  SOUND_LASER,        ///< The player's projectile.
+  SOUND_ENEMY_LASER,  ///< An enemy's projectile.
+  SOUND_EXPLOSION,    ///< Collisions and destructions.
+  SOUND_COUNT         ///< Number of sound effects.
+} SoundId;
+
+/**
+ * @enum AudioMixer
+ * @brief Selects who mixes the sound effects.
+ */
+typedef enum {
+  AUDIO_MIXER_SDL,  ///< SDL_mixer channels, through the voice manager.
+  AUDIO_MIXER_SIMD  ///< The SIMD software mixer, for many short voices.
+} AudioMixer;
+
+/**
+ * @struct AudioVoice
+ * @brief What the voice manager last started on one mixer channel.
+ */
+typedef struct {
+  int sound;       ///< SoundId playing on the channel, or -1 when free.
+  int priority;    ///< Priority of that sound; higher wins a steal.
+  Uint64 started;  ///< Play order of the voice; lower is older.
+} AudioVoice;
+
+/**
+ * @struct AudioStats
+ * @brief Counters of the voice manager's decisions since startup.
+ */
+typedef struct {
+  Uint64 played;    ///< Sounds started, including those that stole a voice.
+  Uint64 stolen;    ///< Voices cut short to make room for a new sound.
+  Uint64 rejected;  ///< Sounds dropped because every voice outranked them.
+} AudioStats;
+
+/**
+ * @struct AudioLatency
+ * @brief The output buffer size and the underruns observed with it.
+ *
+ * `last_callback` belongs to the audio thread and `underruns` is shared;
+ * everything else belongs to the game thread.
+ */
+typedef struct {
+  bool adaptive;           ///< True to resize the buffer on underruns.
+  int buffer_frames;       ///< Sample frames per device callback.
+  int frequency;           ///< Device sample rate (Hz).
+  int frame_bytes;         ///< Bytes per sample frame on the device.
+  Uint64 last_callback;    ///< Performance counter at the last callback.
+  SDL_atomic_t underruns;  ///< Underruns not yet seen by audio_update().
+  Uint64 total_underruns;  ///< Underruns since startup.
+  int window_underruns;    ///< Underruns in the current window.
+  Uint64 window_start;     ///< Tick (ms) the current window began.
+  Uint64 stable_since;     ///< Tick (ms) of the last underrun or resize.
+  Uint32 shrink_delay;     ///< Time (ms) without underruns before shrinking.
+  int resizes;             ///< Times the adaptive mode reopened the device.
+} AudioLatency;
+
 /**
  * @struct AudioContext
- * @brief Holds all loaded SDL_mixer audio resources.
+ * @brief Holds all loaded SDL_mixer audio resources and the state of the
+ * voices playing them.
  */
 typedef struct {
-  Mix_Music* background_music;   ///< The main background music track.
-  Mix_Chunk* laser_sound;        ///< Sound for the player's projectile.
-  Mix_Chunk* explosion_sound;    ///< Sound for collisions and destructions.
-  Mix_Chunk* enemy_laser_sound;  ///< Sound for the enemy's projectile.
+  Mix_Music* background_music;          ///< The main background music track.
+  Mix_Chunk* sounds[SOUND_COUNT];       ///< Sound effects, indexed by SoundId.
+  AudioVoice voices[MAX_AUDIO_VOICES];  ///< One per allocated channel.
+  int voice_count;                      ///< Mixer channels allocated.
+  Uint64 next_voice;                    ///< Play order of the next voice.
+  AudioStats stats;                     ///< Voice manager counters.
+  AudioMixer mixer;                     ///< Who was asked to mix the sound
+                                        ///< effects.
+  struct SfxMixer* sfx_mixer;           ///< The software mixer, or NULL when
+                                        ///< SDL_mixer mixes sound effects.
+  AudioLatency latency;                 ///< Buffer size and underruns.
 } AudioContext;
 
 /**
@@ -57,6 +172,7 @@ typedef struct {
   const Uint8* keyboard_state;  ///< Direct, real-time state of the keyboard.
   bool quit_requested;  ///< True if the user requested to close the game.
   bool f11_pressed;     ///< A single-frame flag for the F11 key press.
+  bool f3_pressed;      ///< A single-frame flag for the F3 key press.
   bool up_pressed;      ///< A single-frame flag for the Up Arrow key press.
   bool down_pressed;    ///< A single-frame flag for the Down Arrow key press.
   bool enter_pressed;   ///< A single-frame flag for the Enter key press.
@@ -0,0 +1,103 @@
+/**
+ * @file alloc_tracker.c
+ * @brief Implements the heap allocation counter.
+ *
+ * The hooks run inside every allocation on every thread, so they only touch
+ * two atomics and call straight through to the previous allocator. Frees
+ * are passed on uncounted.
+ */
+
+#include "core/alloc_tracker.h"
+
+#include <stdio.h>
+
+/**
+ * @struct AllocTracker
+ * @brief The tracker's global state.
+ */
+typedef struct {
+  SDL_malloc_func malloc_func;    ///< The allocator SDL used before.
+  SDL_calloc_func calloc_func;    ///< Likewise, for zeroed blocks.
+  SDL_realloc_func realloc_func;  ///< Likewise, for resizing.
+  SDL_free_func free_func;        ///< Likewise, for freeing.
+  SDL_atomic_t count;             ///< Allocations so far.
+  SDL_atomic_t bytes;             ///< Bytes requested so far.
+  bool installed;                 ///< True once the hooks are in place.
+} AllocTracker;
+
+static AllocTracker tracker;
+
+// --- Private Helpers ---
+
+/**
+ * @brief Counts one allocation.
+ * @param size The bytes it requested.
+ */
+static void count_allocation(size_t size) {
+  SDL_AtomicAdd(&tracker.count, 1);
+  // Totals wrap around like the Uint32 they are read as.
+  SDL_AtomicAdd(&tracker.bytes, (int)(Uint32)size);
+}
+
+/**
+ * @brief The counting replacement for SDL_malloc().
+ */
+static void* tracked_malloc(size_t size) {
+  count_allocation(size);
+  return tracker.malloc_func(size);
+}
+
+/**
+ * @brief The counting replacement for SDL_calloc().
+ */
+static void* tracked_calloc(size_t count, size_t size) {
+  count_allocation(count * size);
+  return tracker.calloc_func(count, size);
+}
+
+/**
+ * @brief The counting replacement for SDL_realloc(). Shrinking a block
+ * counts too, since the allocator may still move it.
+ */
+static void* tracked_realloc(void* memory, size_t size) {
+  count_allocation(size);
+  return tracker.realloc_func(memory, size);
+}
+
+/**
+ * @brief The replacement for SDL_free(), which only passes the call on.
+ */
+static void tracked_free(void* memory) {
+  tracker.free_func(memory);
+}
+
+// --- Public API Implementations ---
+
+bool alloc_tracker_install(void) {
+  SDL_GetMemoryFunctions(&tracker.malloc_func, &tracker.calloc_func,
+                         &tracker.realloc_func, &tracker.free_func);
+  SDL_AtomicSet(&tracker.count, 0);
+  SDL_AtomicSet(&tracker.bytes, 0);
+  if (SDL_SetMemoryFunctions(tracked_malloc, tracked_calloc, tracked_realloc,
+                             tracked_free) < 0) {
+    fprintf(stderr, "ERROR: Failed to hook the SDL allocator: %s\n",
+            SDL_GetError());
+    return false;
+  }
+  tracker.installed = true;
+  return true;
+}
+
+bool alloc_tracker_installed(void) {
+  return tracker.installed;
+}
+
+AllocCounts alloc_tracker_totals(void) {
+  return (AllocCounts){(Uint32)SDL_AtomicGet(&tracker.count),
+                       (Uint32)SDL_AtomicGet(&tracker.bytes)};
+}
+
+AllocCounts alloc_tracker_since(AllocCounts start) {
+  AllocCounts now = alloc_tracker_totals();
+  return (AllocCounts){now.count - start.count, now.bytes - start.bytes};
+}
@@ -0,0 +1,57 @@
+/**
+ * @file arena.c
+ * @brief Implements the linear memory arena.
+ */
+
+#include "core/arena.h"
+
+// --- Private Helpers ---
+
+/**
+ * @brief Rounds a value up to the next multiple of a power-of-two alignment.
+ * @param value The value to round.
+ * @param alignment The alignment, which must be a power of two.
+ * @return The rounded value.
+ */
+static size_t align_up(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// --- Public API Implementations ---
+
+bool arena_init(Arena* arena, size_t capacity) {
+  // Over-allocate so the block can be aligned to a cache line by hand, since
+  // SDL_malloc only guarantees the platform's basic alignment.
+  arena->raw = SDL_malloc(capacity + ARENA_DEFAULT_ALIGNMENT);
+  if (!arena->raw) {
+    *arena = (Arena){0};
+    return false;
+  }
+  arena->base =
+      (Uint8*)align_up((size_t)arena->raw, ARENA_DEFAULT_ALIGNMENT);
+  arena->capacity = capacity;
+  arena->used = 0;
+  return true;
+}
+
+void arena_destroy(Arena* arena) {
+  SDL_free(arena->raw);
+  *arena = (Arena){0};
+}
+
+void* arena_alloc(Arena* arena, size_t size, size_t alignment) {
+  size_t offset = align_up(arena->used, alignment);
+  if (!arena->base) {
+    // Measuring: only record how much space the layout needs.
+    arena->used = offset + size;
+    return NULL;
+  }
+  if (offset + size > arena->capacity)
+    return NULL;
+  arena->used = offset + size;
+  return arena->base + offset;
+}
+
+void arena_reset(Arena* arena) {
+  arena->used = 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * @file asset_loader.c
+ * @brief Implements the background asset loader.
+ *
+ * The loader thread owns SDL_ttf and SDL_image until it finishes. Fonts and
+ * the background come from the asset archive when it holds them, and from
+ * their loose files otherwise; sounds and music are loaded by the audio
+ * module, which makes the same choice.
+ */
+
+#include "core/asset_loader.h"
+
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/audio.h"
+#include "core/glyph_atlas.h"
+#include "core/startup_report.h"
+#include "core/tracer.h"
+#include "utils/constants.h"
+
+/// Point size of each font job.
+static const int FONT_SIZES[ASSET_JOB_FONTS] = {
+    [ASSET_JOB_FONT_NORMAL] = FONT_SIZE_NORMAL,
+    [ASSET_JOB_FONT_LARGE] = FONT_SIZE_LARGE,
+    [ASSET_JOB_FONT_SMALL] = FONT_SIZE_SMALL,
+};
+
+/// The startup phase each job is timed as.
+static const StartupPhase JOB_PHASES[ASSET_JOB_COUNT] = {
+    [ASSET_JOB_FONT_NORMAL] = STARTUP_PHASE_FONT_NORMAL,
+    [ASSET_JOB_FONT_LARGE] = STARTUP_PHASE_FONT_LARGE,
+    [ASSET_JOB_FONT_SMALL] = STARTUP_PHASE_FONT_SMALL,
+    [ASSET_JOB_BACKGROUND] = STARTUP_PHASE_BACKGROUND,
+    [ASSET_JOB_SOUNDS] = STARTUP_PHASE_SOUNDS,
+    [ASSET_JOB_MUSIC] = STARTUP_PHASE_MUSIC,
+};
+
+// --- Private Helpers ---
+
+/**
+ * @brief Opens the UI font at one size and renders its glyph sheet.
+ * @param loader A pointer to the AssetLoader.
+ * @param result A pointer to the job's result.
+ * @param size The point size.
+ */
+static void load_font(AssetLoader* loader, AssetLoadResult* result,
+                      int size) {
+  const AssetEntry* entry =
+      asset_pack_find(loader->pack, FONT_PATH, ASSET_BLOB);
+  // Every size reads the same mapped bytes; each font closes its own stream.
+  result->font = entry ? TTF_OpenFontRW(
+                             asset_pack_open_rw(loader->pack, entry), 1, size)
+                       : TTF_OpenFont(FONT_PATH, size);
+  if (!result->font) {
+    fprintf(stderr, "ERROR: Failed to load font: %s\n", TTF_GetError());
+    result->failed = true;
+    return;
+  }
+  result->pixels = glyph_atlas_build(&result->atlas, result->font);
+  result->failed = result->pixels == NULL;
+}
+
+/**
+ * @brief Decodes the background image, or wraps its pre-decoded pixels in
+ * the asset archive without copying them.
+ * @param loader A pointer to the AssetLoader.
+ * @param result A pointer to the job's result.
+ */
+static void load_background(AssetLoader* loader, AssetLoadResult* result) {
+  const AssetEntry* entry =
+      asset_pack_find(loader->pack, BACKGROUND_IMAGE_PATH, ASSET_IMAGE);
+  if (entry) {
+    // SDL only reads the pixels of a surface it uploads.
+    result->pixels = SDL_CreateRGBSurfaceWithFormatFrom(
+        (void*)asset_pack_data(loader->pack, entry), (int)entry->width,
+        (int)entry->height, 32, (int)entry->pitch, entry->format);
+  } else {
+    result->pixels = IMG_Load(BACKGROUND_IMAGE_PATH);
+  }
+  if (!result->pixels) {
+    // A missing background is not a fatal error; the game can still run.
+    fprintf(stderr, "WARN: Failed to load background image: %s\n",
+            IMG_GetError());
+  }
+}
+
+/**
+ * @brief Runs one job.
+ * @param loader A pointer to the AssetLoader.
+ * @param job The job to run.
+ */
+static void run_job(AssetLoader* loader, AssetJob job) {
+  AssetLoadResult* result = &loader->results[job];
+  switch (job) {
+    case ASSET_JOB_FONT_NORMAL:
+    case ASSET_JOB_FONT_LARGE:
+    case ASSET_JOB_FONT_SMALL:
+      load_font(loader, result, FONT_SIZES[job]);
+      break;
+    case ASSET_JOB_BACKGROUND:
+      load_background(loader, result);
+      break;
+    case ASSET_JOB_SOUNDS:
+      for (int s = 0; s < SOUND_COUNT; s++) {
+        result->sounds[s] = audio_load_sound(loader->pack, (SoundId)s);
+      }
+      break;
+    case ASSET_JOB_MUSIC:
+      result->music = audio_load_music(loader->pack);
+      break;
+    case ASSET_JOB_COUNT:
+      break;
+  }
+}
+
+/**
+ * @brief The main function of the loader thread.
+ * @param data A pointer to the AssetLoader.
+ * @return Always 0.
+ */
+static int loader_main(void* data) {
+  AssetLoader* loader = data;
+  for (int job = 0; job < ASSET_JOB_COUNT; job++) {
+    if (SDL_AtomicGet(&loader->cancel))
+      break;
+    TRACE_BEGIN("asset_load_job");
+    startup_phase_begin(JOB_PHASES[job]);
+    run_job(loader, (AssetJob)job);
+    startup_phase_end(JOB_PHASES[job]);
+    TRACE_END("asset_load_job");
+    SDL_AtomicSet(&loader->completed, job + 1);
+  }
+  return 0;
+}
+
+/**
+ * @brief Installs one completed job. Render thread only.
+ * @param loader A pointer to the AssetLoader.
+ * @param job The job to install.
+ * @param renderer A pointer to the RendererContext.
+ * @param audio A pointer to the AudioContext.
+ * @return false if a required asset failed to load.
+ */
+static bool install_job(AssetLoader* loader, AssetJob job,
+                        RendererContext* renderer, AudioContext* audio) {
+  AssetLoadResult* result = &loader->results[job];
+  TTF_Font** fonts[ASSET_JOB_FONTS] = {
+      [ASSET_JOB_FONT_NORMAL] = &renderer->font_normal,
+      [ASSET_JOB_FONT_LARGE] = &renderer->font_large,
+      [ASSET_JOB_FONT_SMALL] = &renderer->font_small,
+  };
+  GlyphAtlas* atlases[ASSET_JOB_FONTS] = {
+      [ASSET_JOB_FONT_NORMAL] = &renderer->atlas_normal,
+      [ASSET_JOB_FONT_LARGE] = &renderer->atlas_large,
+      [ASSET_JOB_FONT_SMALL] = &renderer->atlas_small,
+  };
+
+  switch (job) {
+    case ASSET_JOB_FONT_NORMAL:
+    case ASSET_JOB_FONT_LARGE:
+    case ASSET_JOB_FONT_SMALL: {
+      // The renderer owns the font from here on, even if the upload fails.
+      *fonts[job] = result->font;
+      result->font = NULL;
+      if (result->failed)
+        return false;
+      *atlases[job] = result->atlas;
+      SDL_Surface* sheet = result->pixels;
+      result->pixels = NULL;
+      return glyph_atlas_upload(atlases[job], renderer->renderer, sheet);
+    }
+    case ASSET_JOB_BACKGROUND:
+      if (result->pixels) {
+        renderer->background_texture =
+            SDL_CreateTextureFromSurface(renderer->renderer, result->pixels);
+        SDL_FreeSurface(result->pixels);
+        result->pixels = NULL;
+      }
+      return true;
+    case ASSET_JOB_SOUNDS:
+      audio_attach_sounds(audio, result->sounds);
+      memset(result->sounds, 0, sizeof(result->sounds));
+      return true;
+    case ASSET_JOB_MUSIC:
+      audio_attach_music(audio, result->music);
+      result->music = NULL;
+      audio_play_music(audio, true);
+      return true;
+    case ASSET_JOB_COUNT:
+      break;
+  }
+  return true;
+}
+
+// --- Public API Implementations ---
+
+bool asset_loader_start(AssetLoader* loader, const AssetPack* pack) {
+  memset(loader, 0, sizeof(*loader));
+  loader->pack = pack;
+  loader->thread = SDL_CreateThread(loader_main, "starfall-loader", loader);
+  if (!loader->thread) {
+    fprintf(stderr, "ERROR: Failed to create asset loader thread: %s\n",
+            SDL_GetError());
+    return false;
+  }
+  return true;
+}
+
+bool asset_loader_poll(AssetLoader* loader, RendererContext* renderer,
+                       AudioContext* audio) {
+  int completed = SDL_AtomicGet(&loader->completed);
+  if (loader->installed == completed)
+    return true;
+  TRACE_BEGIN("asset_loader_poll");
+  bool ok = true;
+  for (; loader->installed < completed && ok; loader->installed++) {
+    ok = install_job(loader, (AssetJob)loader->installed, renderer, audio);
+  }
+  TRACE_END("asset_loader_poll");
+  if (!ok)
+    return false;
+
+  if (asset_loader_done(loader)) {
+    // The thread has nothing left to do; join it so it stops holding
+    // SDL_ttf and the audio device.
+    SDL_WaitThread(loader->thread, NULL);
+    loader->thread = NULL;
+  }
+  return true;
+}
+
+bool asset_loader_fonts_ready(const AssetLoader* loader) {
+  return loader->installed >= ASSET_JOB_FONTS;
+}
+
+bool asset_loader_done(const AssetLoader* loader) {
+  return loader->installed == ASSET_JOB_COUNT;
+}
+
+float asset_loader_progress(const AssetLoader* loader) {
+  return (float)loader->installed / (float)ASSET_JOB_COUNT;
+}
+
+void asset_loader_stop(AssetLoader* loader) {
+  SDL_AtomicSet(&loader->cancel, 1);
+  if (loader->thread) {
+    SDL_WaitThread(loader->thread, NULL);
+    loader->thread = NULL;
+  }
+  // Free whatever was loaded but never installed.
+  int completed = SDL_AtomicGet(&loader->completed);
+  for (int job = loader->installed; job < completed; job++) {
+    AssetLoadResult* result = &loader->results[job];
+    if (result->font)
+      TTF_CloseFont(result->font);
+    if (result->pixels)
+      SDL_FreeSurface(result->pixels);
+    for (int s = 0; s < SOUND_COUNT; s++) {
+      Mix_FreeChunk(result->sounds[s]);
+    }
+    Mix_FreeMusic(result->music);
+  }
+  loader->installed = completed;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file asset_pack.c
+ * @brief Implements the packed asset archive.
+ *
+ * An archive starts with a header and a table of contents (all integers
+ * little-endian):
+ *
+ *     "SFPK"  version:u32  count:u32
+ *     count x { name:char[ASSET_NAME_LENGTH]  type:u32  format:u32
+ *               width:u32  height:u32  pitch:u32  offset:u64  size:u64 }
+ *
+ * followed by the bytes of each entry, starting on a multiple of
+ * ASSET_PACK_ALIGNMENT so pixels and samples can be used in place.
+ *
+ * On POSIX systems the archive is mapped read-only, so only the pages that
+ * are actually touched are read from disk, and they are shared with the page
+ * cache instead of being copied. Elsewhere it is read into memory in one go.
+ */
+
+#include "core/asset_pack.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ASSET_PACK_HAVE_MMAP 1
+#endif
+
+#define ASSET_PACK_MAGIC "SFPK"  // First bytes of every archive.
+#define ASSET_PACK_VERSION 1     // Bumped whenever the format changes.
+#define ASSET_PACK_HEADER_SIZE 12  // Magic, version and entry count.
+#define ASSET_PACK_RECORD_SIZE \
+  (ASSET_NAME_LENGTH + 5 * 4 + 2 * 8)  // One entry of the table.
+
+// --- Private Helpers ---
+
+/**
+ * @brief Reads an unsigned little-endian integer from memory.
+ * @param bytes The first byte of the integer.
+ * @param size The number of bytes to read.
+ * @return The value.
+ */
+static Uint64 get_le(const Uint8* bytes, int size) {
+  Uint64 value = 0;
+  for (int i = 0; i < size; i++) {
+    value |= (Uint64)bytes[i] << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @brief Writes an unsigned integer as little-endian bytes.
+ * @param file The file to write to.
+ * @param value The value to write.
+ * @param size The number of bytes to write.
+ */
+static void write_le(FILE* file, Uint64 value, int size) {
+  for (int i = 0; i < size; i++) {
+    fputc((int)((value >> (8 * i)) & 0xFF), file);
+  }
+}
+
+/**
+ * @brief Rounds an offset up to the alignment of entry data.
+ * @param offset The offset to round.
+ * @return The next multiple of ASSET_PACK_ALIGNMENT.
+ */
+static Uint64 align_offset(Uint64 offset) {
+  return (offset + ASSET_PACK_ALIGNMENT - 1) &
+         ~(Uint64)(ASSET_PACK_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Maps a file into memory, or reads it where mapping is unavailable.
+ * @param pack A pointer to the AssetPack that receives the bytes.
+ * @param path The file to map.
+ * @return true on success, false if the file cannot be opened or is empty.
+ */
+static bool map_file(AssetPack* pack, const char* path) {
+#if defined(ASSET_PACK_HAVE_MMAP)
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  void* data = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && info.st_size > 0)
+    data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file.
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+  pack->data = data;
+  pack->size = (size_t)info.st_size;
+  pack->mapped = true;
+#else
+  size_t size;
+  void* data = SDL_LoadFile(path, &size);
+  if (!data)
+    return false;
+  pack->data = data;
+  pack->size = size;
+  pack->mapped = false;
+#endif
+  return true;
+}
+
+/**
+ * @brief Reads and checks the table of contents.
+ * @param pack A pointer to the AssetPack, with its bytes loaded.
+ * @return true if the header and every entry are valid.
+ */
+static bool read_table(AssetPack* pack) {
+  const Uint8* bytes = pack->data;
+  if (pack->size < ASSET_PACK_HEADER_SIZE ||
+      memcmp(bytes, ASSET_PACK_MAGIC, 4) != 0 ||
+      get_le(bytes + 4, 4) != ASSET_PACK_VERSION)
+    return false;
+  Uint64 count = get_le(bytes + 8, 4);
+  if (count > ASSET_PACK_MAX_ENTRIES ||
+      pack->size < ASSET_PACK_HEADER_SIZE + count * ASSET_PACK_RECORD_SIZE)
+    return false;
+
+  const Uint8* record = bytes + ASSET_PACK_HEADER_SIZE;
+  for (Uint64 i = 0; i < count; i++, record += ASSET_PACK_RECORD_SIZE) {
+    AssetEntry* entry = &pack->entries[i];
+    memcpy(entry->name, record, ASSET_NAME_LENGTH);
+    entry->name[ASSET_NAME_LENGTH - 1] = '\0';
+    const Uint8* field = record + ASSET_NAME_LENGTH;
+    Uint64 type = get_le(field, 4);
+    entry->format = (Uint32)get_le(field + 4, 4);
+    entry->width = (Uint32)get_le(field + 8, 4);
+    entry->height = (Uint32)get_le(field + 12, 4);
+    entry->pitch = (Uint32)get_le(field + 16, 4);
+    entry->offset = get_le(field + 20, 8);
+    entry->size = get_le(field + 28, 8);
+    // Entries are handed to SDL as an int length, and must lie in the file.
+    if (type > ASSET_SOUND || entry->size > SDL_MAX_SINT32 ||
+        entry->offset > pack->size || entry->size > pack->size - entry->offset)
+      return false;
+    entry->type = (AssetType)type;
+  }
+  pack->entry_count = (int)count;
+  return true;
+}
+
+// --- Public API Implementations ---
+
+bool asset_pack_open(AssetPack* pack, const char* path) {
+  memset(pack, 0, sizeof(*pack));
+  if (!map_file(pack, path))
+    return false;
+  if (!read_table(pack)) {
+    fprintf(stderr, "WARN: %s is not a valid asset archive; ignoring it.\n",
+            path);
+    asset_pack_close(pack);
+    return false;
+  }
+  return true;
+}
+
+void asset_pack_close(AssetPack* pack) {
+  if (pack->data) {
+#if defined(ASSET_PACK_HAVE_MMAP)
+    munmap((void*)pack->data, pack->size);
+#else
+    SDL_free((void*)pack->data);
+#endif
+  }
+  memset(pack, 0, sizeof(*pack));
+}
+
+const AssetEntry* asset_pack_find(const AssetPack* pack, const char* name,
+                                  AssetType type) {
+  for (int i = 0; i < pack->entry_count; i++) {
+    const AssetEntry* entry = &pack->entries[i];
+    if (entry->type == type && strcmp(entry->name, name) == 0)
+      return entry;
+  }
+  return NULL;
+}
+
+const void* asset_pack_data(const AssetPack* pack, const AssetEntry* entry) {
+  return pack->data + entry->offset;
+}
+
+SDL_RWops* asset_pack_open_rw(const AssetPack* pack, const AssetEntry* entry) {
+  return SDL_RWFromConstMem(asset_pack_data(pack, entry), (int)entry->size);
+}
+
+bool asset_pack_write(const char* path, AssetEntry* entries,
+                      const void* const* data, int count) {
+  if (count < 0 || count > ASSET_PACK_MAX_ENTRIES) {
+    fprintf(stderr, "ERROR: An archive holds at most %d entries.\n",
+            ASSET_PACK_MAX_ENTRIES);
+    return false;
+  }
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    fprintf(stderr, "ERROR: Failed to create asset archive %s.\n", path);
+    return false;
+  }
+
+  Uint64 offset = align_offset(ASSET_PACK_HEADER_SIZE +
+                               (Uint64)count * ASSET_PACK_RECORD_SIZE);
+  for (int i = 0; i < count; i++) {
+    entries[i].offset = offset;
+    offset = align_offset(offset + entries[i].size);
+  }
+
+  fwrite(ASSET_PACK_MAGIC, 1, 4, file);
+  write_le(file, ASSET_PACK_VERSION, 4);
+  write_le(file, (Uint64)count, 4);
+  for (int i = 0; i < count; i++) {
+    const AssetEntry* entry = &entries[i];
+    char name[ASSET_NAME_LENGTH] = {0};
+    SDL_strlcpy(name, entry->name, sizeof(name));
+    fwrite(name, 1, sizeof(name), file);
+    write_le(file, (Uint64)entry->type, 4);
+    write_le(file, entry->format, 4);
+    write_le(file, entry->width, 4);
+    write_le(file, entry->height, 4);
+    write_le(file, entry->pitch, 4);
+    write_le(file, entry->offset, 8);
+    write_le(file, entry->size, 8);
+  }
+
+  Uint64 written = ASSET_PACK_HEADER_SIZE +
+                   (Uint64)count * ASSET_PACK_RECORD_SIZE;
+  for (int i = 0; i < count; i++) {
+    for (; written < entries[i].offset; written++) {
+      fputc(0, file);
+    }
+    fwrite(data[i], 1, (size_t)entries[i].size, file);
+    written += entries[i].size;
+  }
+
+  bool ok = !ferror(file);
+  if (fclose(file) != 0 || !ok) {
+    fprintf(stderr, "ERROR: Failed to write asset archive %s.\n", path);
+    return false;
+  }
+  return true;
+}
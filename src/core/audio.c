@@ -4,60 +4,350 @@
  *
  * This file contains the logic for initializing SDL_mixer, loading audio
  * assets, and controlling playback of sounds and music.
+ *
+ * The voice manager tracks what it started on each channel. Finished voices
+ * are noticed by polling Mix_Playing() before each decision rather than
+ * through Mix_ChannelFinished(), whose callback runs on the audio thread.
  */
 
 #include "core/audio.h"
 
 #include <stdio.h>
 
+#include "core/sfx_mixer.h"
+#include "core/startup_report.h"
+#include "core/tracer.h"
+
+/**
+ * @struct SoundSpec
+ * @brief How a sound effect is loaded, mixed and prioritized.
+ */
+typedef struct {
+  const char* path;  ///< The sound file (.wav).
+  int volume;        ///< Chunk volume, from 0 to MIX_MAX_VOLUME.
+  int max_voices;    ///< Voices the sound may hold at once.
+  int priority;      ///< Higher priorities may steal lower ones' voices.
+} SoundSpec;
+
+/// Explosions report hits and kills, so they outrank the far more frequent
+/// laser sounds, and enemy lasers give way to everything else.
+static const SoundSpec SOUND_SPECS[SOUND_COUNT] = {
+    [SOUND_LASER] = {"assets/sounds/projectiles.wav", 40, 4, 1},
+    [SOUND_ENEMY_LASER] = {"assets/sounds/enemy_laser_sound.wav", 62, 3, 0},
+    [SOUND_EXPLOSION] = {"assets/sounds/explosion.wav", 82, 4, 2},
+};
+
 // --- Private Helpers ---
 
 /**
- * @brief Loads a sound chunk from a file and reports any errors.
- * @param path The file path to the sound asset (.wav).
- * @return A pointer to the loaded Mix_Chunk, or NULL on failure.
+ * @brief Marks the voices whose channel has stopped playing as free.
+ * @param audio A pointer to the AudioContext.
  */
-static Mix_Chunk* load_sound(const char* path) {
-  Mix_Chunk* chunk = Mix_LoadWAV(path);
-  if (!chunk) {
-    fprintf(stderr, "ERROR: Failed to load sound %s: %s\n", path,
-            Mix_GetError());
+static void release_finished_voices(AudioContext* audio) {
+  for (int c = 0; c < audio->voice_count; c++) {
+    if (audio->voices[c].sound >= 0 && !Mix_Playing(c))
+      audio->voices[c].sound = -1;
   }
-  return chunk;
 }
 
-// --- Public API Implementations ---
+/**
+ * @brief Picks the channel a sound should play on.
+ * @param audio A pointer to the AudioContext.
+ * @param sound The sound about to play.
+ * @param steal A pointer that receives true if the channel is busy and its
+ * voice will be cut short.
+ * @return The channel, or -1 if the sound should be dropped.
+ */
+static int choose_voice(const AudioContext* audio, SoundId sound,
+                        bool* steal) {
+  const AudioVoice* voices = audio->voices;
+  int free_voice = -1;
+  int oldest_same = -1;
+  int same_count = 0;
+  int victim = -1;
+  for (int c = 0; c < audio->voice_count; c++) {
+    const AudioVoice* voice = &voices[c];
+    if (voice->sound < 0) {
+      if (free_voice < 0)
+        free_voice = c;
+      continue;
+    }
+    if (voice->sound == (int)sound) {
+      same_count++;
+      if (oldest_same < 0 || voice->started < voices[oldest_same].started)
+        oldest_same = c;
+    }
+    // The lowest priority loses first; among equals, the oldest voice,
+    // which has the least left to play.
+    if (victim < 0 || voice->priority < voices[victim].priority ||
+        (voice->priority == voices[victim].priority &&
+         voice->started < voices[victim].started))
+      victim = c;
+  }
+
+  *steal = true;
+  if (same_count >= SOUND_SPECS[sound].max_voices)
+    return oldest_same;
+  if (free_voice >= 0) {
+    *steal = false;
+    return free_voice;
+  }
+  if (victim >= 0 && voices[victim].priority <= SOUND_SPECS[sound].priority)
+    return victim;
+  return -1;
+}
+
+/**
+ * @brief SDL_mixer's post-mix hook: watches the callback timing for
+ * underruns and adds the software mixer's voices, if any, to the mixed
+ * buffer. Runs on the audio thread.
+ * @param udata A pointer to the AudioContext.
+ * @param stream The mixed buffer, in the device format.
+ * @param len The length of the buffer in bytes.
+ */
+static void post_mix(void* udata, Uint8* stream, int len) {
+  AudioContext* audio = udata;
+  AudioLatency* latency = &audio->latency;
+  int frames = len / latency->frame_bytes;
+
+  // The device asks for the next buffer while it plays the previous one. A
+  // callback arriving much later than one buffer length after the last one
+  // means the device ran dry in between and played silence.
+  Uint64 now = SDL_GetPerformanceCounter();
+  Uint64 expected = (Uint64)frames * SDL_GetPerformanceFrequency() /
+                    (Uint64)latency->frequency;
+  if (latency->last_callback != 0 &&
+      now - latency->last_callback > AUDIO_UNDERRUN_FACTOR * expected)
+    SDL_AtomicIncRef(&latency->underruns);
+  latency->last_callback = now;
 
-bool audio_init(AudioContext* audio) {
-  if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+  if (audio->sfx_mixer)
+    sfx_mixer_mix(audio->sfx_mixer, (Sint16*)stream, frames);
+}
+
+/**
+ * @brief Opens the audio device with a given buffer size and allocates the
+ * sound effect channels on it.
+ * @param audio A pointer to the AudioContext; `voice_count` holds the number
+ * of channels to allocate.
+ * @param buffer_frames The sample frames per device callback.
+ * @return true if the device is open, false otherwise.
+ */
+static bool open_device(AudioContext* audio, int buffer_frames) {
+  if (Mix_OpenAudio(AUDIO_SAMPLE_RATE, MIX_DEFAULT_FORMAT, 2, buffer_frames) <
+      0) {
     fprintf(stderr, "ERROR: Failed to initialize SDL_mixer: %s\n",
             Mix_GetError());
     return false;
   }
+  AudioLatency* latency = &audio->latency;
+  int channels;
+  Uint16 format;
+  Mix_QuerySpec(&latency->frequency, &format, &channels);
+  latency->frame_bytes = SDL_AUDIO_BITSIZE(format) / 8 * channels;
+  latency->buffer_frames = buffer_frames;
+  latency->last_callback = 0;
+  SDL_AtomicSet(&latency->underruns, 0);
 
-  audio->background_music = Mix_LoadMUS("assets/sounds/background.mp3");
-  if (!audio->background_music) {
-    fprintf(stderr, "ERROR: Failed to load music: %s\n", Mix_GetError());
-    // This is not a fatal error; the game can run without music.
+  // Opening the device resets the music volume, and closing it halted every
+  // channel.
+  Mix_VolumeMusic(40);
+  audio->voice_count = Mix_AllocateChannels(audio->voice_count);
+  for (int c = 0; c < MAX_AUDIO_VOICES; c++) {
+    audio->voices[c].sound = -1;
   }
+  return true;
+}
 
-  // Load all sound effects.
-  audio->laser_sound = load_sound("assets/sounds/projectiles.wav");
-  audio->explosion_sound = load_sound("assets/sounds/explosion.wav");
-  audio->enemy_laser_sound = load_sound("assets/sounds/enemy_laser_sound.wav");
+/**
+ * @brief Reopens the audio device with a new buffer size, resuming the
+ * music from its start if it was playing.
+ *
+ * SDL cannot resize the buffer of an open device, and SDL_mixer keeps the
+ * loaded chunks in the device format, which reopening with the same request
+ * does not change.
+ * @param audio A pointer to the AudioContext.
+ * @param buffer_frames The new sample frames per device callback.
+ */
+static void resize_buffer(AudioContext* audio, int buffer_frames) {
+  AudioLatency* latency = &audio->latency;
+  int previous = latency->buffer_frames;
+  bool music = Mix_PlayingMusic();
+  Mix_SetPostMix(NULL, NULL);
+  Mix_CloseAudio();
+  if (!open_device(audio, buffer_frames)) {
+    latency->adaptive = false;
+    if (!open_device(audio, previous)) {
+      fprintf(stderr, "WARN: Audio is off after a failed buffer resize.\n");
+      latency->buffer_frames = 0;
+      return;
+    }
+  }
+  Mix_SetPostMix(post_mix, audio);
+  if (music)
+    audio_play_music(audio, true);
+  latency->resizes++;
+}
 
-  // Set default volumes to balance the audio mix.
-  if (audio->laser_sound)
-    Mix_VolumeChunk(audio->laser_sound, 40);
-  if (audio->explosion_sound)
-    Mix_VolumeChunk(audio->explosion_sound, 82);
-  if (audio->enemy_laser_sound)
-    Mix_VolumeChunk(audio->enemy_laser_sound, 62);
-  Mix_VolumeMusic(40);
+/**
+ * @brief Hands the loaded sound effects to a new software mixer and hooks it
+ * into SDL_mixer.
+ * @param audio A pointer to the AudioContext, with its sounds loaded.
+ * @return true if the software mixer runs, false if SDL_mixer has to mix the
+ * sound effects.
+ */
+static bool start_sfx_mixer(AudioContext* audio) {
+  int frequency, channels;
+  Uint16 format;
+  if (!Mix_QuerySpec(&frequency, &format, &channels) ||
+      format != AUDIO_S16SYS || channels != 2) {
+    fprintf(stderr,
+            "WARN: The software mixer needs 16-bit stereo output; using "
+            "SDL_mixer.\n");
+    return false;
+  }
+  SfxMixer* mixer = SDL_malloc(sizeof(SfxMixer));
+  if (!mixer) {
+    fprintf(stderr, "WARN: Failed to allocate the software mixer.\n");
+    return false;
+  }
+  sfx_mixer_init(mixer);
+  // SDL_mixer already converted every chunk to the device format on load.
+  for (int s = 0; s < SOUND_COUNT; s++) {
+    Mix_Chunk* chunk = audio->sounds[s];
+    if (chunk) {
+      sfx_mixer_set_sound(mixer, s, (const Sint16*)chunk->abuf,
+                          (int)(chunk->alen / (2 * sizeof(Sint16))));
+    }
+  }
+  audio->sfx_mixer = mixer;
+  return true;
+}
+
+// --- Public API Implementations ---
 
+bool audio_init(AudioContext* audio, int voice_count, AudioMixer mixer,
+                int buffer_frames) {
+  SDL_memset(audio, 0, sizeof(*audio));
+  audio->mixer = mixer;
+  AudioLatency* latency = &audio->latency;
+  latency->adaptive = buffer_frames == 0;
+  if (latency->adaptive)
+    buffer_frames = AUDIO_LOW_LATENCY_FRAMES;
+  latency->shrink_delay = AUDIO_SHRINK_DELAY_MS;
+  latency->window_start = latency->stable_since = SDL_GetTicks64();
+  audio->voice_count = SDL_clamp(voice_count, 1, MAX_AUDIO_VOICES);
+  startup_phase_begin(STARTUP_PHASE_OPEN_AUDIO);
+  if (!open_device(audio, buffer_frames))
+    return false;
+  startup_phase_end(STARTUP_PHASE_OPEN_AUDIO);
+  // Hook in last: from here on the audio thread reads the context.
+  Mix_SetPostMix(post_mix, audio);
   return true;
 }
 
+Mix_Chunk* audio_load_sound(const AssetPack* pack, SoundId sound) {
+  const char* path = SOUND_SPECS[sound].path;
+  const AssetEntry* entry = asset_pack_find(pack, path, ASSET_SOUND);
+  int frequency, channels;
+  Uint16 format;
+  Mix_Chunk* chunk = NULL;
+  // A packed sound is already in the device format, so the chunk plays the
+  // mapped samples in place; SDL_mixer only reads them. If the device format
+  // differs from the one it was packed for, the loose file is decoded.
+  if (entry && Mix_QuerySpec(&frequency, &format, &channels) &&
+      entry->format == format && entry->width == (Uint32)frequency &&
+      entry->height == (Uint32)channels) {
+    chunk = Mix_QuickLoad_RAW((Uint8*)asset_pack_data(pack, entry),
+                              (Uint32)entry->size);
+  }
+  if (!chunk)
+    chunk = Mix_LoadWAV(path);
+  if (!chunk) {
+    fprintf(stderr, "ERROR: Failed to load sound %s: %s\n", path,
+            Mix_GetError());
+    return NULL;
+  }
+  // Play every sound at a volume that balances the audio mix.
+  Mix_VolumeChunk(chunk, SOUND_SPECS[sound].volume);
+  return chunk;
+}
+
+Mix_Music* audio_load_music(const AssetPack* pack) {
+  const AssetEntry* entry = asset_pack_find(pack, MUSIC_PATH, ASSET_BLOB);
+  // SDL_mixer decodes packed music from the stream as it plays, and closes
+  // the stream when the music is freed.
+  Mix_Music* music = entry
+                         ? Mix_LoadMUS_RW(asset_pack_open_rw(pack, entry), 1)
+                         : Mix_LoadMUS(MUSIC_PATH);
+  if (!music) {
+    // This is not a fatal error; the game can run without music.
+    fprintf(stderr, "ERROR: Failed to load music: %s\n", Mix_GetError());
+  }
+  return music;
+}
+
+void audio_attach_sounds(AudioContext* audio,
+                         Mix_Chunk* const sounds[SOUND_COUNT]) {
+  for (int s = 0; s < SOUND_COUNT; s++) {
+    audio->sounds[s] = sounds[s];
+  }
+  if (audio->mixer == AUDIO_MIXER_SIMD) {
+    // The audio thread must not see the software mixer half set up.
+    Mix_SetPostMix(NULL, NULL);
+    start_sfx_mixer(audio);
+    Mix_SetPostMix(post_mix, audio);
+  }
+}
+
+void audio_attach_music(AudioContext* audio, Mix_Music* music) {
+  audio->background_music = music;
+}
+
+void audio_update(AudioContext* audio) {
+  AudioLatency* latency = &audio->latency;
+  if (latency->buffer_frames == 0)
+    return;
+  int underruns = SDL_AtomicSet(&latency->underruns, 0);
+  latency->total_underruns += (Uint64)underruns;
+  if (!latency->adaptive)
+    return;
+
+  Uint64 now = SDL_GetTicks64();
+  if (now - latency->window_start >= AUDIO_UNDERRUN_WINDOW_MS) {
+    latency->window_start = now;
+    latency->window_underruns = 0;
+  }
+  if (underruns > 0) {
+    latency->window_underruns += underruns;
+    latency->stable_since = now;
+  }
+
+  int frames = latency->buffer_frames;
+  if (latency->window_underruns >= AUDIO_UNDERRUNS_TO_GROW &&
+      frames < AUDIO_MAX_BUFFER_FRAMES) {
+    // Each grow makes the next shrink wait longer, so a buffer that is only
+    // just too small is not retried over and over.
+    resize_buffer(audio, frames * 2);
+    latency->shrink_delay =
+        SDL_min(latency->shrink_delay * 2, AUDIO_MAX_SHRINK_DELAY_MS);
+  } else if (frames > AUDIO_LOW_LATENCY_FRAMES &&
+             now - latency->stable_since >= latency->shrink_delay) {
+    resize_buffer(audio, frames / 2);
+  } else {
+    return;
+  }
+  latency->window_start = latency->stable_since = now;
+  latency->window_underruns = 0;
+}
+
+float audio_latency_ms(const AudioContext* audio) {
+  const AudioLatency* latency = &audio->latency;
+  if (latency->frequency <= 0)
+    return 0.0f;
+  return 1000.0f * (float)latency->buffer_frames / (float)latency->frequency;
+}
+
 void audio_play_music(AudioContext* audio, bool loop) {
   if (audio->background_music) {
     // A loop value of -1 tells SDL_mixer to loop indefinitely.
@@ -65,23 +355,72 @@ void audio_play_music(AudioContext* audio, bool loop) {
   }
 }
 
-void audio_play_sound(AudioContext* audio, Mix_Chunk* sound) {
-  // The 'audio' parameter is unused here but is kept for API consistency.
-  // This allows the audio system to become more stateful in the future without
-  // changing function signatures.
-  (void)audio;
-  if (sound) {
-    // Play on the first free channel (-1) without looping (0).
-    Mix_PlayChannel(-1, sound, 0);
+void audio_play_sound(AudioContext* audio, SoundId sound) {
+  Mix_Chunk* chunk = audio->sounds[sound];
+  if (!chunk)
+    return;
+  TRACE_BEGIN("audio_play_sound");
+  if (audio->sfx_mixer) {
+    float gain = (float)SOUND_SPECS[sound].volume / MIX_MAX_VOLUME;
+    if (sfx_mixer_play(audio->sfx_mixer, (int)sound, gain)) {
+      audio->stats.played++;
+    } else {
+      audio->stats.rejected++;
+    }
+    TRACE_END("audio_play_sound");
+    return;
   }
+  release_finished_voices(audio);
+  bool steal;
+  int channel = choose_voice(audio, sound, &steal);
+  // Starting a chunk on a busy channel halts what it was playing.
+  if (channel >= 0 && Mix_PlayChannel(channel, chunk, 0) >= 0) {
+    AudioVoice* voice = &audio->voices[channel];
+    voice->sound = (int)sound;
+    voice->priority = SOUND_SPECS[sound].priority;
+    voice->started = audio->next_voice++;
+    audio->stats.played++;
+    if (steal)
+      audio->stats.stolen++;
+  } else {
+    audio->stats.rejected++;
+  }
+  TRACE_END("audio_play_sound");
 }
 
 void audio_cleanup(AudioContext* audio) {
+  // Unhook first; once Mix_SetPostMix() returns, the audio thread no longer
+  // touches the context.
+  Mix_SetPostMix(NULL, NULL);
+  AudioLatency* latency = &audio->latency;
+  latency->total_underruns += (Uint64)SDL_AtomicSet(&latency->underruns, 0);
+  int voice_count = audio->voice_count;
+  if (audio->sfx_mixer) {
+    audio->stats.stolen += audio->sfx_mixer->stolen;
+    voice_count = SFX_MAX_VOICES;
+    SDL_free(audio->sfx_mixer);
+    audio->sfx_mixer = NULL;
+  }
+  if (audio->stats.played > 0 || audio->stats.rejected > 0) {
+    printf("Audio: %llu sounds played on %d voices, %llu voices stolen, "
+           "%llu sounds rejected.\n",
+           (unsigned long long)audio->stats.played, voice_count,
+           (unsigned long long)audio->stats.stolen,
+           (unsigned long long)audio->stats.rejected);
+  }
+
+  if (latency->buffer_frames > 0) {
+    printf("Audio: %d-frame buffer (%.1f ms%s), %llu underruns, %d resizes.\n",
+           latency->buffer_frames, audio_latency_ms(audio),
+           latency->adaptive ? ", adaptive" : "",
+           (unsigned long long)latency->total_underruns, latency->resizes);
+  }
+
   // Free all loaded audio resources.
   Mix_FreeMusic(audio->background_music);
-  Mix_FreeChunk(audio->laser_sound);
-  Mix_FreeChunk(audio->explosion_sound);
-  Mix_FreeChunk(audio->enemy_laser_sound);
+  for (int s = 0; s < SOUND_COUNT; s++) {
+    Mix_FreeChunk(audio->sounds[s]);
+  }
 
   // Shut down the SDL_mixer subsystem.
   Mix_CloseAudio();
@@ -0,0 +1,404 @@
+/**
+ * @file config.c
+ * @brief Implements parsing of the startup configuration.
+ *
+ * Command-line options and config file entries share one table of names, so
+ * every setting is available through both.
+ */
+
+#include "core/config.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct OptionInfo
+ * @brief Describes one supported setting for parsing and the usage text.
+ */
+typedef struct {
+  const char* name;        ///< The option name, without the leading `--`.
+  const char* value_hint;  ///< Placeholder for the value, or NULL for flags.
+  const char* help;        ///< One-line description for the usage text.
+} OptionInfo;
+
+static const OptionInfo OPTIONS[] = {
+    {"config", "FILE", "Load settings from FILE (name = value per line)."},
+    {"max-projectiles", "N", "Capacity of the projectile pool."},
+    {"max-enemies", "N", "Capacity of the enemy pool."},
+    {"collisions", "grid|brute", "Collision broadphase to use."},
+    {"seed", "N", "Seed for a reproducible game (random by default)."},
+    {"sim-rate", "HZ", "Simulation ticks per second (default 60)."},
+    {"spawn-rate", "N", "Enemies spawned per 60 Hz tick (default 0.03)."},
+    {"ai-budget", "N", "Enemy AI timers handled per tick; 0 = no limit."},
+    {"threads", "N", "Threads to simulate on; 0 uses every core."},
+    {"voices", "N", "Mixer channels for sound effects (default 16)."},
+    {"mixer", "sdl|simd", "Mix sound effects with SDL_mixer or in software."},
+    {"audio-buffer", "auto|N", "Audio frames per callback (default 2048)."},
+    {"vsync", "on|off", "Sync frames to the display; 'off' is uncapped."},
+    {"trace", "FILE", "Record a timeline to FILE (chrome://tracing)."},
+    {"record", "FILE", "Record every tick's input to a replay FILE."},
+    {"replay", "FILE", "Play back a replay FILE instead of live input."},
+    {"record-hashes", "FILE", "Record the world hash of every tick to FILE."},
+    {"verify-hashes", "FILE", "Report the first tick differing from FILE."},
+    {"startup-report", NULL, "Time startup and shutdown; exit once loaded."},
+    {"alloc-check", NULL, "Fail if a frame allocates memory after warm-up."},
+    {"help", NULL, "Show this help and exit."},
+};
+
+// --- Private Helpers ---
+
+/**
+ * @brief Finds the description of an option by name.
+ * @param name The option name, without the leading `--`.
+ * @return A pointer to the OptionInfo, or NULL if the name is unknown.
+ */
+static const OptionInfo* find_option(const char* name) {
+  for (size_t i = 0; i < SDL_arraysize(OPTIONS); i++) {
+    if (strcmp(OPTIONS[i].name, name) == 0)
+      return &OPTIONS[i];
+  }
+  return NULL;
+}
+
+/**
+ * @brief Parses an integer setting, rejecting anything outside a range.
+ * @param name The option name, for error messages.
+ * @param value The text to parse.
+ * @param min The smallest accepted value.
+ * @param max The largest accepted value.
+ * @param out A pointer that receives the parsed value.
+ * @return true if the value is valid.
+ */
+static bool parse_int_range(const char* name, const char* value, int min,
+                            int max, int* out) {
+  char* end;
+  errno = 0;
+  long parsed = strtol(value, &end, 10);
+  if (errno != 0 || end == value || *end != '\0' || parsed < min ||
+      parsed > max) {
+    fprintf(stderr, "ERROR: --%s expects a number from %d to %d, got '%s'.\n",
+            name, min, max, value);
+    return false;
+  }
+  *out = (int)parsed;
+  return true;
+}
+
+/**
+ * @brief Parses a decimal setting, rejecting anything outside a range.
+ * @param name The option name, for error messages.
+ * @param value The text to parse.
+ * @param min The smallest accepted value.
+ * @param max The largest accepted value.
+ * @param out A pointer that receives the parsed value.
+ * @return true if the value is valid.
+ */
+static bool parse_float_range(const char* name, const char* value, float min,
+                              float max, float* out) {
+  char* end;
+  errno = 0;
+  float parsed = strtof(value, &end);
+  if (errno != 0 || end == value || *end != '\0' || !(parsed >= min) ||
+      parsed > max) {
+    fprintf(stderr, "ERROR: --%s expects a number from %g to %g, got '%s'.\n",
+            name, min, max, value);
+    return false;
+  }
+  *out = parsed;
+  return true;
+}
+
+/**
+ * @brief Parses an on/off switch.
+ * @param name The option name, for error messages.
+ * @param value The text to parse.
+ * @param out A pointer that receives the parsed value.
+ * @return true if the value is valid.
+ */
+static bool parse_switch(const char* name, const char* value, bool* out) {
+  if (strcmp(value, "on") == 0) {
+    *out = true;
+  } else if (strcmp(value, "off") == 0) {
+    *out = false;
+  } else {
+    fprintf(stderr, "ERROR: --%s expects 'on' or 'off'.\n", name);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Parses a random seed, accepting any unsigned 64-bit value.
+ * @param value The text to parse.
+ * @param out A pointer that receives the parsed value.
+ * @return true if the value is valid.
+ */
+static bool parse_seed(const char* value, Uint64* out) {
+  char* end;
+  errno = 0;
+  unsigned long long parsed = strtoull(value, &end, 10);
+  if (errno != 0 || end == value || *end != '\0' || value[0] == '-') {
+    fprintf(stderr, "ERROR: --seed expects a non-negative number, got '%s'.\n",
+            value);
+    return false;
+  }
+  *out = (Uint64)parsed;
+  return true;
+}
+
+/**
+ * @brief Copies a file path setting, rejecting paths that do not fit.
+ * @param name The option name, for error messages.
+ * @param value The path to copy.
+ * @param out The buffer of MAX_PATH_LENGTH bytes that receives the path.
+ * @return true if the path fits.
+ */
+static bool parse_path(const char* name, const char* value, char* out) {
+  if (strlen(value) >= MAX_PATH_LENGTH) {
+    fprintf(stderr, "ERROR: --%s path is longer than %d characters.\n", name,
+            MAX_PATH_LENGTH - 1);
+    return false;
+  }
+  strcpy(out, value);
+  return true;
+}
+
+static bool load_file(GameConfig* config, const char* path, int depth);
+
+/**
+ * @brief Applies a single setting.
+ * @param config A pointer to the GameConfig to update.
+ * @param name The option name, without the leading `--`.
+ * @param value The option value, or NULL for flags.
+ * @param depth The number of config files the setting is nested in; 0 on
+ * the command line.
+ * @return true if the setting was applied.
+ */
+static bool apply_option(GameConfig* config, const char* name,
+                         const char* value, int depth) {
+  if (strcmp(name, "config") == 0)
+    return load_file(config, value, depth + 1);
+  if (strcmp(name, "max-projectiles") == 0)
+    return parse_int_range(name, value, 1, MAX_POOL_CAPACITY,
+                           &config->world.max_projectiles);
+  if (strcmp(name, "max-enemies") == 0)
+    return parse_int_range(name, value, 1, MAX_POOL_CAPACITY,
+                           &config->world.max_enemies);
+  if (strcmp(name, "collisions") == 0) {
+    if (strcmp(value, "grid") == 0) {
+      config->world.collision_mode = COLLISION_MODE_GRID;
+    } else if (strcmp(value, "brute") == 0) {
+      config->world.collision_mode = COLLISION_MODE_BRUTE_FORCE;
+    } else {
+      fprintf(stderr, "ERROR: --collisions expects 'grid' or 'brute'.\n");
+      return false;
+    }
+    return true;
+  }
+  if (strcmp(name, "seed") == 0) {
+    if (!parse_seed(value, &config->world.seed))
+      return false;
+    config->random_seed = false;
+    return true;
+  }
+  if (strcmp(name, "sim-rate") == 0)
+    return parse_int_range(name, value, MIN_SIM_RATE, MAX_SIM_RATE,
+                           &config->world.tick_rate);
+  if (strcmp(name, "spawn-rate") == 0)
+    return parse_float_range(name, value, 0.0f, MAX_ENEMY_SPAWN_RATE,
+                             &config->world.enemy_spawn_rate);
+  if (strcmp(name, "ai-budget") == 0)
+    return parse_int_range(name, value, 0, MAX_POOL_CAPACITY,
+                           &config->world.ai_event_budget);
+  if (strcmp(name, "threads") == 0)
+    return parse_int_range(name, value, 0, THREAD_POOL_MAX_THREADS,
+                           &config->threads);
+  if (strcmp(name, "voices") == 0)
+    return parse_int_range(name, value, 1, MAX_AUDIO_VOICES,
+                           &config->voices);
+  if (strcmp(name, "mixer") == 0) {
+    if (strcmp(value, "sdl") == 0) {
+      config->mixer = AUDIO_MIXER_SDL;
+    } else if (strcmp(value, "simd") == 0) {
+      config->mixer = AUDIO_MIXER_SIMD;
+    } else {
+      fprintf(stderr, "ERROR: --mixer expects 'sdl' or 'simd'.\n");
+      return false;
+    }
+    return true;
+  }
+  if (strcmp(name, "audio-buffer") == 0) {
+    if (strcmp(value, "auto") == 0) {
+      config->audio_buffer = 0;
+      return true;
+    }
+    int frames;
+    if (!parse_int_range(name, value, AUDIO_MIN_BUFFER_FRAMES,
+                         AUDIO_MAX_BUFFER_FRAMES, &frames))
+      return false;
+    if (frames & (frames - 1)) {
+      fprintf(stderr, "ERROR: --audio-buffer expects a power of two.\n");
+      return false;
+    }
+    config->audio_buffer = frames;
+    return true;
+  }
+  if (strcmp(name, "vsync") == 0)
+    return parse_switch(name, value, &config->vsync);
+  if (strcmp(name, "trace") == 0)
+    return parse_path(name, value, config->trace_path);
+  if (strcmp(name, "record") == 0)
+    return parse_path(name, value, config->record_path);
+  if (strcmp(name, "replay") == 0)
+    return parse_path(name, value, config->replay_path);
+  if (strcmp(name, "record-hashes") == 0)
+    return parse_path(name, value, config->record_hashes_path);
+  if (strcmp(name, "verify-hashes") == 0)
+    return parse_path(name, value, config->verify_hashes_path);
+  if (strcmp(name, "startup-report") == 0) {
+    config->startup_report = true;
+    return true;
+  }
+  if (strcmp(name, "alloc-check") == 0) {
+    config->alloc_check = true;
+    return true;
+  }
+  if (strcmp(name, "help") == 0) {
+    config->show_help = true;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Removes leading and trailing whitespace in place.
+ * @param text The string to trim.
+ * @return A pointer to the first non-whitespace character.
+ */
+static char* trim(char* text) {
+  while (isspace((unsigned char)*text))
+    text++;
+  char* end = text + strlen(text);
+  while (end > text && isspace((unsigned char)end[-1]))
+    end--;
+  *end = '\0';
+  return text;
+}
+
+/**
+ * @brief Applies the settings from a config file, which may include others.
+ * @param config A pointer to the GameConfig to update.
+ * @param path The path of the config file.
+ * @param depth The nesting level of the file; 1 for a file named on the
+ * command line or passed to config_load_file().
+ * @return true if the file was read and every setting was valid.
+ */
+static bool load_file(GameConfig* config, const char* path, int depth) {
+  // A file that includes itself, directly or through others, would
+  // otherwise recurse until the stack runs out.
+  if (depth > MAX_CONFIG_DEPTH) {
+    fprintf(stderr,
+            "ERROR: Config files nested more than %d deep at %s; does one "
+            "include itself?\n",
+            MAX_CONFIG_DEPTH, path);
+    return false;
+  }
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    fprintf(stderr, "ERROR: Failed to open config file %s.\n", path);
+    return false;
+  }
+
+  char line[256];
+  int line_number = 0;
+  bool ok = true;
+  while (ok && fgets(line, sizeof(line), file)) {
+    line_number++;
+    char* text = trim(line);
+    if (*text == '\0' || *text == '#')
+      continue;
+
+    // Flags are written as a bare name; other settings as "name = value".
+    char* value = NULL;
+    char* separator = strchr(text, '=');
+    if (separator) {
+      *separator = '\0';
+      value = trim(separator + 1);
+    }
+    char* name = trim(text);
+
+    const OptionInfo* option = find_option(name);
+    if (!option || (option->value_hint != NULL) != (value != NULL)) {
+      fprintf(stderr, "ERROR: %s:%d: invalid setting '%s'.\n", path,
+              line_number, name);
+      ok = false;
+    } else {
+      ok = apply_option(config, name, value, depth);
+    }
+  }
+
+  fclose(file);
+  return ok;
+}
+
+// --- Public API Implementations ---
+
+void config_init(GameConfig* config) {
+  world_config_init(&config->world);
+  config->vsync = true;
+  config->random_seed = true;
+  config->show_help = false;
+  config->startup_report = false;
+  config->alloc_check = false;
+  config->threads = 1;
+  config->voices = DEFAULT_AUDIO_VOICES;
+  config->mixer = AUDIO_MIXER_SDL;
+  config->audio_buffer = AUDIO_BUFFER_FRAMES;
+  config->trace_path[0] = '\0';
+  config->record_path[0] = '\0';
+  config->replay_path[0] = '\0';
+  config->record_hashes_path[0] = '\0';
+  config->verify_hashes_path[0] = '\0';
+}
+
+bool config_load_file(GameConfig* config, const char* path) {
+  return load_file(config, path, 1);
+}
+
+bool config_parse_args(GameConfig* config, int argc, char* argv[]) {
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const OptionInfo* option =
+        strncmp(arg, "--", 2) == 0 ? find_option(arg + 2) : NULL;
+    if (!option) {
+      fprintf(stderr, "ERROR: Unknown option '%s'.\n", arg);
+      return false;
+    }
+
+    const char* value = NULL;
+    if (option->value_hint) {
+      if (i + 1 >= argc) {
+        fprintf(stderr, "ERROR: Option '%s' expects a value.\n", arg);
+        return false;
+      }
+      value = argv[++i];
+    }
+    if (!apply_option(config, option->name, value, 0))
+      return false;
+  }
+  return true;
+}
+
+void config_print_usage(const char* program) {
+  printf("Usage: %s [options]\n\nOptions:\n", program);
+  for (size_t i = 0; i < SDL_arraysize(OPTIONS); i++) {
+    char left[48];
+    snprintf(left, sizeof(left), "--%s%s%s", OPTIONS[i].name,
+             OPTIONS[i].value_hint ? " " : "",
+             OPTIONS[i].value_hint ? OPTIONS[i].value_hint : "");
+    printf("  %-30s %s\n", left, OPTIONS[i].help);
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file frame_arena.c
+ * @brief Implements the double-buffered per-frame arena.
+ */
+
+#include "core/frame_arena.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+// --- Private Helpers ---
+
+/**
+ * @brief Counts a request that did not fit, warning about the first one.
+ * @param arena A pointer to the FrameArena.
+ */
+static void note_overflow(FrameArena* arena) {
+  if (arena->overflows++ == 0) {
+    fprintf(stderr,
+            "WARN: The frame arena is full (%llu bytes); raise "
+            "FRAME_ARENA_BYTES.\n",
+            (unsigned long long)arena->buffers[arena->current].capacity);
+  }
+}
+
+// --- Public API Implementations ---
+
+bool frame_arena_init(FrameArena* arena, size_t capacity) {
+  *arena = (FrameArena){0};
+  if (!arena_init(&arena->buffers[0], capacity) ||
+      !arena_init(&arena->buffers[1], capacity)) {
+    fprintf(stderr, "ERROR: Failed to allocate the frame arena.\n");
+    frame_arena_destroy(arena);
+    return false;
+  }
+  return true;
+}
+
+void frame_arena_destroy(FrameArena* arena) {
+  arena_destroy(&arena->buffers[0]);
+  arena_destroy(&arena->buffers[1]);
+  arena->current = 0;
+}
+
+void frame_arena_begin(FrameArena* arena) {
+  arena->current ^= 1;
+  arena_reset(&arena->buffers[arena->current]);
+}
+
+void* frame_arena_alloc(FrameArena* arena, size_t size, size_t alignment) {
+  Arena* buffer = &arena->buffers[arena->current];
+  void* memory = arena_alloc(buffer, size, alignment);
+  if (!memory) {
+    note_overflow(arena);
+    return NULL;
+  }
+  arena->high_water = SDL_max(arena->high_water, buffer->used);
+  return memory;
+}
+
+char* frame_arena_printf(FrameArena* arena, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  va_list measure;
+  va_copy(measure, args);
+  int length = vsnprintf(NULL, 0, format, measure);
+  va_end(measure);
+  char* text = NULL;
+  if (length >= 0)
+    text = frame_arena_alloc(arena, (size_t)length + 1, 1);
+  if (text)
+    vsnprintf(text, (size_t)length + 1, format, args);
+  va_end(args);
+  return text;
+}
+
+size_t frame_arena_used(const FrameArena* arena) {
+  return arena->buffers[arena->current].used;
+}
+
+void frame_arena_rewind(FrameArena* arena, size_t used) {
+  Arena* buffer = &arena->buffers[arena->current];
+  buffer->used = SDL_min(buffer->used, used);
+}
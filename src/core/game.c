@@ -12,72 +12,269 @@
 #include <stdio.h>
 #include <time.h>
 
+#include "core/alloc_tracker.h"
+#include "core/asset_loader.h"
 #include "core/audio.h"
 #include "core/input.h"
+#include "core/profiler.h"
 #include "core/renderer.h"
+#include "core/startup_report.h"
+#include "core/tracer.h"
 #include "game/world.h"
 #include "utils/constants.h"
 
 // --- Private Function Prototypes ---
 static void game_handle_input(Game* game);
+static void game_capture_tick_input(Game* game, TickInput* tick);
+static void game_handle_events(Game* game);
 static void game_update(Game* game);
-static void game_render(Game* game);
+static void game_render(Game* game, float alpha);
+static void game_check_allocations(Game* game, AllocCounts allocs);
 
 // --- Public API Implementations ---
 
-bool game_init(Game* game) {
+bool game_init(Game* game, const GameConfig* config) {
+  startup_report_init();
+  game->presented = false;
+  game->config = *config;
+  // The hooks must be in place before SDL allocates anything.
+  if (game->config.alloc_check && !alloc_tracker_install())
+    return false;
+  game->alloc_warmup = ALLOC_CHECK_WARMUP;
+  game->alloc_resizes = 0;
+  game->checked_frames = 0;
+  game->alloc_frames = 0;
+  if (game->config.random_seed) {
+    // Without an explicit seed, every launch plays a different game.
+    game->config.world.seed =
+        (Uint64)time(NULL) ^ SDL_GetPerformanceCounter();
+  }
+  if (game->config.trace_path[0] != '\0' &&
+      !tracer_init(game->config.trace_path))
+    return false;
+
+  // A replay brings its own seed, tick rate and pool sizes, so it must be
+  // opened before the world is created from those settings.
+  game->replay.file = NULL;
+  game->recording.file = NULL;
+  if (game->config.replay_path[0] != '\0' &&
+      !replay_open(&game->replay, game->config.replay_path,
+                   &game->config.world))
+    return false;
+  if (game->config.record_path[0] != '\0' &&
+      !replay_create(&game->recording, game->config.record_path,
+                     &game->config.world))
+    return false;
+  game->hashes.file = NULL;
+  game->reference.file = NULL;
+  if (game->config.record_hashes_path[0] != '\0' &&
+      !hash_trace_create(&game->hashes, game->config.record_hashes_path,
+                         game->config.world.seed))
+    return false;
+  if (game->config.verify_hashes_path[0] != '\0' &&
+      !hash_trace_open(&game->reference, game->config.verify_hashes_path,
+                       game->config.world.seed))
+    return false;
+  startup_phase_begin(STARTUP_PHASE_SDL_INIT);
   if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
     fprintf(stderr, "ERROR: Failed to initialize SDL: %s\n", SDL_GetError());
     return false;
   }
-
-  // Initialize all game subsystems.
-  if (!renderer_init(&game->renderer))
+  startup_phase_end(STARTUP_PHASE_SDL_INIT);
+
+  // Initialize all game subsystems, then load the assets in the background
+  // so frames are presented meanwhile. Without an asset archive, every asset
+  // is loaded from its loose file instead.
+  startup_phase_begin(STARTUP_PHASE_ASSET_PACK);
+  asset_pack_open(&game->assets, ASSET_PACK_PATH);
+  startup_phase_end(STARTUP_PHASE_ASSET_PACK);
+  if (!frame_arena_init(&game->frame_arena, FRAME_ARENA_BYTES))
     return false;
-  if (!audio_init(&game->audio))
+  if (!renderer_init(&game->renderer, game->config.vsync, &game->frame_arena))
+    return false;
+  if (!audio_init(&game->audio, game->config.voices, game->config.mixer,
+                  game->config.audio_buffer))
+    return false;
+  if (!asset_loader_start(&game->loader, &game->assets))
     return false;
 
-  world_init(&game->world);
+  startup_phase_begin(STARTUP_PHASE_WORLD);
+  if (!world_init(&game->world, &game->config.world))
+    return false;
+  startup_phase_end(STARTUP_PHASE_WORLD);
+  startup_phase_begin(STARTUP_PHASE_THREAD_POOL);
+  if (!thread_pool_init(&game->thread_pool, game->config.threads))
+    return false;
+  startup_phase_end(STARTUP_PHASE_THREAD_POOL);
+  world_set_thread_pool(&game->world, &game->thread_pool);
+  world_set_frame_arena(&game->world, &game->frame_arena);
   input_init(&game->input);
+#ifdef STARFALL_PROFILE
+  profiler_init();
+#endif
 
   // Set initial game state.
   game->is_running = true;
-  game->current_state = GAME_STATE_MENU;
+  game->current_state = GAME_STATE_LOADING;
   game->menu_option = 0;
-
-  // Seed the random number generator.
-  srand((unsigned int)time(NULL));
-  audio_play_music(&game->audio, true);
+  game->fire_requested = false;
+  SDL_memset(game->tick_keys, 0, sizeof(game->tick_keys));
+  if (game->replay.file) {
+    // Playback starts straight in the game, as if Play had been chosen.
+    game->current_state = GAME_STATE_PLAYING;
+    world_reset(&game->world);
+  }
   return true;
 }
 
 void game_run(Game* game) {
-  Uint32 frame_start_time;
-  int frame_duration;
+  const Uint64 tick_duration =
+      SDL_GetPerformanceFrequency() / (Uint64)game->world.tick_rate;
+  Uint64 previous_time = SDL_GetPerformanceCounter();
+  Uint64 accumulator = 0;
 
   // This is the main application loop.
   while (game->is_running) {
-    frame_start_time = SDL_GetTicks();
-
-    // The three core phases of the game loop.
+    AllocCounts frame_allocs = alloc_tracker_totals();
+    // Scratch memory from two frames ago is reused from here on.
+    frame_arena_begin(&game->frame_arena);
+    PROFILE_BEGIN(PROFILE_ZONE_FRAME);
+    TRACE_BEGIN("frame");
+    Uint64 now = SDL_GetPerformanceCounter();
+    accumulator += now - previous_time;
+    previous_time = now;
+
+    PROFILE_BEGIN(PROFILE_ZONE_INPUT);
+    TRACE_BEGIN("game_handle_input");
     game_handle_input(game);
-    game_update(game);
-    game_render(game);
-
-    // This implements a fixed timestep by delaying if the frame finished early.
-    // It ensures a consistent game speed regardless of hardware performance.
-    frame_duration = SDL_GetTicks() - frame_start_time;
-    if (frame_duration < FRAME_DELAY) {
-      SDL_Delay(FRAME_DELAY - frame_duration);
+    TRACE_END("game_handle_input");
+    PROFILE_END(PROFILE_ZONE_INPUT);
+
+    // Install the assets loaded since the last frame; the menu opens as soon
+    // as it has fonts to draw with.
+    if (!asset_loader_done(&game->loader)) {
+      if (!asset_loader_poll(&game->loader, &game->renderer, &game->audio))
+        game->is_running = false;
+      if (game->current_state == GAME_STATE_LOADING &&
+          asset_loader_fonts_ready(&game->loader))
+        game->current_state = GAME_STATE_MENU;
+    } else {
+      // Collect audio underruns and resize the buffer if they call for it.
+      // Reopening the device would pull it from under the loader, so this
+      // waits until loading is done.
+      audio_update(&game->audio);
+    }
+
+    // Run as many fixed ticks as the elapsed time calls for, so the game
+    // speed is independent of the frame rate.
+    int ticks = 0;
+    while (accumulator >= tick_duration && ticks < MAX_TICKS_PER_FRAME) {
+      TRACE_BEGIN("game_update");
+      game_update(game);
+      TRACE_END("game_update");
+      accumulator -= tick_duration;
+      ticks++;
+    }
+    // If the simulation cannot keep up (or the window was dragged or
+    // suspended), drop the backlog instead of trying to catch up forever;
+    // the game slows down rather than freezing.
+    if (accumulator >= tick_duration)
+      accumulator %= tick_duration;
+
+    TRACE_BEGIN("game_render");
+    game_render(game, (float)accumulator / (float)tick_duration);
+    TRACE_END("game_render");
+    if (!game->presented) {
+      game->presented = true;
+      startup_phase_mark(STARTUP_PHASE_FIRST_FRAME);
+    }
+    // The assets installed at the top of the frame were all drawn with it.
+    if (game->config.startup_report && asset_loader_done(&game->loader)) {
+      startup_phase_mark(STARTUP_PHASE_LOADED_FRAME);
+      startup_report_print_startup();
+      game->is_running = false;
     }
+    TRACE_END("frame");
+    PROFILE_END(PROFILE_ZONE_FRAME);
+    PROFILE_FRAME_END();
+    if (game->config.alloc_check)
+      game_check_allocations(game, alloc_tracker_since(frame_allocs));
   }
 }
 
-void game_cleanup(Game* game) {
+bool game_cleanup(Game* game) {
+  // Shots and spawns are dropped when a pool is full; make that visible so the
+  // capacities can be raised for the next run.
+  int dropped_projectiles = game->world.projectiles.slots.dropped;
+  int dropped_enemies = game->world.enemies.slots.dropped;
+  if (dropped_projectiles > 0 || dropped_enemies > 0) {
+    fprintf(stderr,
+            "WARN: Pools were full: dropped %d projectiles (capacity %d) and "
+            "%d enemies (capacity %d).\n",
+            dropped_projectiles, game->config.world.max_projectiles,
+            dropped_enemies, game->config.world.max_enemies);
+  }
+
+  startup_phase_begin(STARTUP_PHASE_SHUTDOWN);
+#ifdef STARFALL_PROFILE
+  profiler_shutdown();
+#endif
+  replay_close(&game->replay);
+  replay_close(&game->recording);
+  bool hashes_ok = hash_trace_close(&game->hashes);
+  bool verified = hash_trace_close(&game->reference);
+  startup_phase_begin(STARTUP_PHASE_STOP_WORKERS);
+  thread_pool_destroy(&game->thread_pool);
+  startup_phase_end(STARTUP_PHASE_STOP_WORKERS);
+  startup_phase_begin(STARTUP_PHASE_FREE_WORLD);
+  world_destroy(&game->world);
+  startup_phase_end(STARTUP_PHASE_FREE_WORLD);
+  startup_phase_begin(STARTUP_PHASE_STOP_LOADER);
+  asset_loader_stop(&game->loader);
+  startup_phase_end(STARTUP_PHASE_STOP_LOADER);
+  startup_phase_begin(STARTUP_PHASE_CLOSE_RENDERER);
   renderer_cleanup(&game->renderer);
+  startup_phase_end(STARTUP_PHASE_CLOSE_RENDERER);
+  // The peak is for sizing FRAME_ARENA_BYTES, so only the diagnostic runs
+  // report it.
+  bool report_frame_arena =
+      game->config.startup_report || game->config.alloc_check;
+#ifdef STARFALL_PROFILE
+  report_frame_arena = true;
+#endif
+  if (report_frame_arena) {
+    printf("Frame arena: peak %llu of %llu bytes per frame.\n",
+           (unsigned long long)game->frame_arena.high_water,
+           (unsigned long long)FRAME_ARENA_BYTES);
+  }
+  frame_arena_destroy(&game->frame_arena);
+  startup_phase_begin(STARTUP_PHASE_CLOSE_AUDIO);
   audio_cleanup(&game->audio);
+  startup_phase_end(STARTUP_PHASE_CLOSE_AUDIO);
+  // The workers, the loader and the audio callback all record events, so
+  // the trace is only written once all three have stopped.
+  tracer_shutdown();
+  asset_pack_close(&game->assets);
+  startup_phase_begin(STARTUP_PHASE_SDL_QUIT);
   SDL_Quit();
+  startup_phase_end(STARTUP_PHASE_SDL_QUIT);
+  startup_phase_end(STARTUP_PHASE_SHUTDOWN);
+  if (game->config.startup_report)
+    startup_report_print_shutdown();
   printf("Game cleaned up successfully.\n");
+
+  if (!game->config.alloc_check)
+    return hashes_ok && verified;
+  if (game->alloc_frames > 0) {
+    fprintf(stderr,
+            "ERROR: Allocation check failed: %d of %d frames after "
+            "warm-up allocated.\n",
+            game->alloc_frames, game->checked_frames);
+    return false;
+  }
+  printf("Allocation check passed: %d frames after warm-up allocated "
+         "nothing.\n", game->checked_frames);
+  return hashes_ok && verified;
 }
 
 // --- Private Function Implementations ---
@@ -97,9 +294,15 @@ static void game_handle_input(Game* game) {
   if (game->input.f11_pressed) {
     renderer_toggle_fullscreen(&game->renderer);
   }
+  if (game->input.f3_pressed) {
+    game->renderer.show_debug = !game->renderer.show_debug;
+  }
 
   // Handle input differently depending on the current game scene.
   switch (game->current_state) {
+    case GAME_STATE_LOADING:
+      // Nothing to select until the menu can be drawn.
+      break;
     case GAME_STATE_MENU: {
       SDL_Rect play_rect = renderer_get_text_rect(
           &game->renderer, "Play", LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 2);
@@ -131,6 +334,7 @@ static void game_handle_input(Game* game) {
         if (game->menu_option == 0) {
           game->current_state = GAME_STATE_PLAYING;
           world_reset(&game->world);
+          game->fire_requested = false;
         } else {
           game->is_running = false;
         }
@@ -139,11 +343,12 @@ static void game_handle_input(Game* game) {
     }
 
     case GAME_STATE_PLAYING:
-      // Player firing logic is tied to Spacebar or Right Mouse Button.
-      if (game->input.space_pressed || game->input.right_mouse_clicked) {
-        world_fire_player_projectile(&game->world, &game->renderer,
-                                     game->input.mouse_x, game->input.mouse_y,
-                                     &game->audio);
+      // Player firing logic is tied to Spacebar or Right Mouse Button. The
+      // shot is latched until the next tick, since a frame may run none.
+      // During playback, shots come from the replay instead.
+      if (!game->replay.file &&
+          (game->input.space_pressed || game->input.right_mouse_clicked)) {
+        game->fire_requested = true;
       }
       break;
 
@@ -180,6 +385,7 @@ static void game_handle_input(Game* game) {
         if (game->menu_option == 0) {  // Restart
           game->current_state = GAME_STATE_PLAYING;
           world_reset(&game->world);
+          game->fire_requested = false;
         } else {  // Main Menu
           game->current_state = GAME_STATE_MENU;
         }
@@ -190,42 +396,198 @@ static void game_handle_input(Game* game) {
 }
 
 /**
- * @brief Updates the game logic for the current frame.
+ * @brief Collects the player's input for the next simulation tick.
+ * @param game A pointer to the main Game struct.
+ * @param tick A pointer to the TickInput to fill.
+ */
+static void game_capture_tick_input(Game* game, TickInput* tick) {
+  tick_input_capture(tick, game->input.keyboard_state);
+  tick->fire = game->fire_requested;
+  game->fire_requested = false;
+
+  // Aim in whole logical pixels, exactly as a replay stores it.
+  float logical_x, logical_y;
+  renderer_window_to_logical(&game->renderer, game->input.mouse_x,
+                             game->input.mouse_y, &logical_x, &logical_y);
+  tick->aim_x = (int)logical_x;
+  tick->aim_y = (int)logical_y;
+}
+
+/**
+ * @brief Reacts to the events the world reported during the last tick, then
+ * clears them.
+ *
+ * A burst of identical sounds in one tick would only stack into one louder,
+ * clipping sound and use up voices, so each sound is played at most once per
+ * tick however many events ask for it.
+ * @param game A pointer to the main Game struct.
+ */
+static void game_handle_events(Game* game) {
+  GameEventBuffer* events = &game->world.events;
+  bool played[SOUND_COUNT] = {false};
+  for (int i = 0; i < events->count; i++) {
+    SoundId sound;
+    switch (events->events[i].type) {
+      case GAME_EVENT_PLAYER_SHOT:
+        sound = SOUND_LASER;
+        break;
+      case GAME_EVENT_ENEMY_SHOT:
+        sound = SOUND_ENEMY_LASER;
+        break;
+      case GAME_EVENT_ENEMY_KILLED:
+      case GAME_EVENT_PLAYER_HIT:
+        sound = SOUND_EXPLOSION;
+        break;
+      case GAME_EVENT_GAME_OVER:
+        game->current_state = GAME_STATE_GAME_OVER;
+        continue;
+      default:
+        continue;
+    }
+    if (!played[sound]) {
+      played[sound] = true;
+      audio_play_sound(&game->audio, sound);
+    }
+  }
+  game_events_clear(events);
+}
+
+/**
+ * @brief Advances the game logic by one simulation tick.
+ *
+ * The world only sees the tick's TickInput, whether it comes from the player
+ * or from a replay, so recorded and replayed sessions play out identically.
  * @param game A pointer to the main Game struct.
  */
 static void game_update(Game* game) {
   // Game logic is only updated when in the 'playing' state.
-  if (game->current_state == GAME_STATE_PLAYING) {
-    world_update(&game->world, &game->input, &game->audio);
-    world_check_collisions(&game->world, &game->audio, &game->current_state);
+  if (game->current_state != GAME_STATE_PLAYING)
+    return;
+
+  TickInput tick;
+  if (game->replay.file) {
+    if (!replay_read_tick(&game->replay, &tick)) {
+      printf("Replay finished after %llu ticks.\n",
+             (unsigned long long)game->replay.ticks);
+      game->is_running = false;
+      return;
+    }
+  } else {
+    game_capture_tick_input(game, &tick);
+  }
+  if (game->recording.file)
+    replay_write_tick(&game->recording, &tick);
+
+  tick_input_apply(&tick, game->tick_keys);
+  InputState tick_state = {0};
+  tick_state.keyboard_state = game->tick_keys;
+  if (tick.fire) {
+    world_fire_player_projectile(&game->world, tick.aim_x, tick.aim_y);
+  }
+  PROFILE_BEGIN(PROFILE_ZONE_WORLD_UPDATE);
+  world_update(&game->world, &tick_state);
+  PROFILE_END(PROFILE_ZONE_WORLD_UPDATE);
+  PROFILE_BEGIN(PROFILE_ZONE_COLLISIONS);
+  world_check_collisions(&game->world);
+  PROFILE_END(PROFILE_ZONE_COLLISIONS);
+  game_handle_events(game);
+  if (game->hashes.file || game->reference.file) {
+    Uint64 hash = world_hash(&game->world);
+    if (game->hashes.file)
+      hash_trace_write(&game->hashes, hash);
+    if (game->reference.file)
+      hash_trace_verify(&game->reference, hash, game->world.tick);
+  }
+
+  // The recorded player restarted after every game over (or the recording
+  // ends there), so playback restarts right away.
+  if (game->replay.file && game->current_state == GAME_STATE_GAME_OVER) {
+    world_reset(&game->world);
+    game->current_state = GAME_STATE_PLAYING;
   }
 }
 
 /**
  * @brief Renders the current game scene based on the game state.
  * @param game A pointer to the main Game struct.
+ * @param alpha How far the frame lies between the previous and the latest
+ * simulation tick, used to interpolate entity positions.
  */
-static void game_render(Game* game) {
+static void game_render(Game* game, float alpha) {
+  PROFILE_BEGIN(PROFILE_ZONE_RENDER);
   renderer_prepare_frame(&game->renderer);
 
   // Render a different scene depending on the current game state.
   switch (game->current_state) {
+    case GAME_STATE_LOADING:
+      renderer_draw_loading(&game->renderer,
+                            asset_loader_progress(&game->loader));
+      break;
     case GAME_STATE_MENU:
       renderer_draw_menu(&game->renderer, game->menu_option);
       break;
     case GAME_STATE_PLAYING:
-      renderer_draw_game(&game->renderer, &game->world);
+      renderer_draw_game(&game->renderer, &game->world, alpha);
       renderer_draw_hud(&game->renderer, &game->world);
       break;
     case GAME_STATE_GAME_OVER:
       // Draw the final game state in the background to show where the player
-      // died.
-      renderer_draw_game(&game->renderer, &game->world);
+      // died. The simulation is stopped, so there is nothing to interpolate.
+      renderer_draw_game(&game->renderer, &game->world, 1.0f);
       renderer_draw_hud(&game->renderer, &game->world);
       // Draw the overlay menu on top.
       renderer_draw_game_over(&game->renderer, &game->world, game->menu_option);
       break;
   }
+  if (game->renderer.show_debug) {
+    renderer_draw_debug(&game->renderer, &game->audio);
+  }
+  PROFILE_END(PROFILE_ZONE_RENDER);
 
+  PROFILE_BEGIN(PROFILE_ZONE_PRESENT);
   renderer_present_frame(&game->renderer);
+  PROFILE_END(PROFILE_ZONE_PRESENT);
+}
+
+/**
+ * @brief Checks that a frame made no heap allocations, once the game has
+ * warmed up.
+ *
+ * Loading, reopening the audio device and switching to fullscreen allocate
+ * by design, and the first frames after them may still grow SDL's internal
+ * buffers, so each of them restarts the warm-up.
+ * @param game A pointer to the main Game struct.
+ * @param allocs The allocations made during the frame.
+ */
+static void game_check_allocations(Game* game, AllocCounts allocs) {
+  if (!asset_loader_done(&game->loader) || game->input.f11_pressed ||
+      game->audio.latency.resizes != game->alloc_resizes) {
+    game->alloc_resizes = game->audio.latency.resizes;
+    game->alloc_warmup = ALLOC_CHECK_WARMUP;
+    return;
+  }
+  if (game->alloc_warmup > 0) {
+    game->alloc_warmup--;
+    return;
+  }
+
+  game->checked_frames++;
+  if (allocs.count == 0)
+    return;
+  game->alloc_frames++;
+  if (game->alloc_frames > ALLOC_CHECK_MAX_REPORTS)
+    return;
+  fprintf(stderr,
+          "ERROR: Frame %d after warm-up made %u allocations (%u bytes).\n",
+          game->checked_frames, (unsigned)allocs.count, (unsigned)allocs.bytes);
+#ifdef STARFALL_PROFILE
+  for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+    AllocCounts zone = profiler_last_allocs((ProfileZone)z);
+    if (zone.count > 0) {
+      fprintf(stderr, "  %-13s %u allocations (%u bytes)\n",
+              profiler_zone_name((ProfileZone)z), (unsigned)zone.count,
+              (unsigned)zone.bytes);
+    }
+  }
+#endif
 }
@@ -0,0 +1,203 @@
+/**
+ * @file glyph_atlas.c
+ * @brief Implements the glyph atlas text renderer.
+ *
+ * Glyphs are packed into the atlas in rows ("shelves") from left to right.
+ * Drawing a string emits one quad per visible character into a fixed-size
+ * vertex buffer on the stack and submits it with SDL_RenderGeometry(), so a
+ * typical string costs a single draw call.
+ */
+
+#include "core/glyph_atlas.h"
+
+#include <stdio.h>
+
+#include "utils/constants.h"
+
+// --- Private Helpers ---
+
+/**
+ * @brief Maps a character to its index in the atlas.
+ * @param c The character to look up.
+ * @return The glyph index; characters outside the atlas map to '?'.
+ */
+static int glyph_index(unsigned char c) {
+  if (c < GLYPH_ATLAS_FIRST || c >= GLYPH_ATLAS_FIRST + GLYPH_ATLAS_COUNT)
+    c = '?';
+  return c - GLYPH_ATLAS_FIRST;
+}
+
+/**
+ * @brief Submits a batch of glyph quads in a single draw call.
+ * @param atlas A constant pointer to the GlyphAtlas being drawn.
+ * @param renderer The renderer to draw with.
+ * @param vertices The quad vertices, four per glyph.
+ * @param quads The number of quads in the batch.
+ */
+static void flush_quads(const GlyphAtlas* atlas, SDL_Renderer* renderer,
+                        const SDL_Vertex* vertices, int quads) {
+  // Every quad uses the same two-triangle pattern over its four vertices.
+  int indices[TEXT_BATCH_GLYPHS * 6];
+  for (int q = 0; q < quads; q++) {
+    int base = q * 4;
+    int* quad = &indices[q * 6];
+    quad[0] = base;
+    quad[1] = base + 1;
+    quad[2] = base + 2;
+    quad[3] = base + 2;
+    quad[4] = base + 3;
+    quad[5] = base;
+  }
+  SDL_RenderGeometry(renderer, atlas->texture, vertices, quads * 4, indices,
+                     quads * 6);
+}
+
+// --- Public API Implementations ---
+
+SDL_Surface* glyph_atlas_build(GlyphAtlas* atlas, TTF_Font* font) {
+  SDL_Surface* surfaces[GLYPH_ATLAS_COUNT] = {0};
+  SDL_Color white = {255, 255, 255, 255};
+  atlas->texture = NULL;
+
+  // Pass 1: render each glyph on its own and assign it a place in the atlas.
+  int pen_x = 0, pen_y = 0, row_height = 0;
+  for (int i = 0; i < GLYPH_ATLAS_COUNT; i++) {
+    Uint16 c = (Uint16)(GLYPH_ATLAS_FIRST + i);
+    Glyph* glyph = &atlas->glyphs[i];
+    glyph->source = (SDL_Rect){0, 0, 0, 0};
+    if (TTF_GlyphMetrics(font, c, NULL, NULL, NULL, NULL, &glyph->advance) !=
+        0)
+      glyph->advance = 0;
+
+    // Blank glyphs only advance the pen and need no pixels.
+    if (c == ' ')
+      continue;
+    SDL_Surface* surface = TTF_RenderGlyph_Blended(font, c, white);
+    if (!surface)
+      continue;
+    if (pen_x + surface->w > GLYPH_ATLAS_WIDTH) {
+      pen_x = 0;
+      pen_y += row_height + GLYPH_ATLAS_PADDING;
+      row_height = 0;
+    }
+    glyph->source = (SDL_Rect){pen_x, pen_y, surface->w, surface->h};
+    pen_x += surface->w + GLYPH_ATLAS_PADDING;
+    if (surface->h > row_height)
+      row_height = surface->h;
+    surfaces[i] = surface;
+  }
+
+  // Pass 2: copy every glyph into one sheet, to be uploaded at once.
+  SDL_Surface* sheet =
+      SDL_CreateRGBSurfaceWithFormat(0, GLYPH_ATLAS_WIDTH, pen_y + row_height,
+                                     32, SDL_PIXELFORMAT_RGBA32);
+  for (int i = 0; i < GLYPH_ATLAS_COUNT; i++) {
+    if (!surfaces[i])
+      continue;
+    if (sheet) {
+      // Copy the glyph's alpha as-is instead of blending it onto the sheet.
+      SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+      SDL_BlitSurface(surfaces[i], NULL, sheet, &atlas->glyphs[i].source);
+    }
+    SDL_FreeSurface(surfaces[i]);
+  }
+  if (!sheet) {
+    fprintf(stderr, "ERROR: Failed to create glyph atlas surface: %s\n",
+            SDL_GetError());
+    return NULL;
+  }
+  atlas->texture_w = (float)sheet->w;
+  atlas->texture_h = (float)sheet->h;
+
+  // Kerning is looked up once per pair here instead of on every draw.
+  for (int left = 0; left < GLYPH_ATLAS_COUNT; left++) {
+    for (int right = 0; right < GLYPH_ATLAS_COUNT; right++) {
+      int kerning = TTF_GetFontKerningSizeGlyphs(
+          font, (Uint16)(GLYPH_ATLAS_FIRST + left),
+          (Uint16)(GLYPH_ATLAS_FIRST + right));
+      atlas->kerning[left][right] = (Sint8)SDL_clamp(kerning, -128, 127);
+    }
+  }
+
+  atlas->line_height = TTF_FontHeight(font);
+  return sheet;
+}
+
+bool glyph_atlas_upload(GlyphAtlas* atlas, SDL_Renderer* renderer,
+                        SDL_Surface* sheet) {
+  atlas->texture = SDL_CreateTextureFromSurface(renderer, sheet);
+  SDL_FreeSurface(sheet);
+  if (!atlas->texture) {
+    fprintf(stderr, "ERROR: Failed to create glyph atlas texture: %s\n",
+            SDL_GetError());
+    return false;
+  }
+  SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+  return true;
+}
+
+void glyph_atlas_destroy(GlyphAtlas* atlas) {
+  SDL_DestroyTexture(atlas->texture);
+  atlas->texture = NULL;
+}
+
+void glyph_atlas_measure(const GlyphAtlas* atlas, const char* text, int* w,
+                         int* h) {
+  int width = 0;
+  int previous = -1;
+  for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+    int i = glyph_index(*c);
+    if (previous >= 0)
+      width += atlas->kerning[previous][i];
+    width += atlas->glyphs[i].advance;
+    previous = i;
+  }
+  *w = width;
+  *h = atlas->line_height;
+}
+
+int glyph_atlas_draw(const GlyphAtlas* atlas, SDL_Renderer* renderer,
+                     const char* text, float x, float y, SDL_Color color) {
+  if (!atlas->texture)
+    return 0;
+
+  SDL_Vertex vertices[TEXT_BATCH_GLYPHS * 4];
+  int quads = 0;
+  int draw_calls = 0;
+  float pen_x = x;
+  int previous = -1;
+  for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+    int i = glyph_index(*c);
+    if (previous >= 0)
+      pen_x += atlas->kerning[previous][i];
+    previous = i;
+
+    const Glyph* glyph = &atlas->glyphs[i];
+    const SDL_Rect* src = &glyph->source;
+    if (src->w > 0) {
+      if (quads == TEXT_BATCH_GLYPHS) {
+        flush_quads(atlas, renderer, vertices, quads);
+        draw_calls++;
+        quads = 0;
+      }
+      float u0 = src->x / atlas->texture_w;
+      float v0 = src->y / atlas->texture_h;
+      float u1 = (src->x + src->w) / atlas->texture_w;
+      float v1 = (src->y + src->h) / atlas->texture_h;
+      float x1 = pen_x + src->w;
+      float y1 = y + src->h;
+      SDL_Vertex* quad = &vertices[quads * 4];
+      quad[0] = (SDL_Vertex){{pen_x, y}, color, {u0, v0}};
+      quad[1] = (SDL_Vertex){{x1, y}, color, {u1, v0}};
+      quad[2] = (SDL_Vertex){{x1, y1}, color, {u1, v1}};
+      quad[3] = (SDL_Vertex){{pen_x, y1}, color, {u0, v1}};
+      quads++;
+    }
+    pen_x += glyph->advance;
+  }
+  if (quads > 0) {
+    flush_quads(atlas, renderer, vertices, quads);
+    draw_calls++;
+  }
+  return draw_calls;
+}
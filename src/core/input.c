@@ -8,6 +8,8 @@
 
 #include "core/input.h"
 
+#include "core/tracer.h"
+
 void input_init(InputState* input) {
   // Get a pointer to SDL's internal keyboard state array. This array is managed
   // by SDL and provides real-time key states.
@@ -18,11 +20,13 @@ void input_init(InputState* input) {
 }
 
 void input_poll(InputState* input) {
+  TRACE_BEGIN("input_poll");
   // Reset all single-frame event flags at the beginning of each frame.
   // This ensures that an event from one frame isn't accidentally processed
   // in the next.
   input->quit_requested = false;
   input->f11_pressed = false;
+  input->f3_pressed = false;
   input->up_pressed = false;
   input->down_pressed = false;
   input->enter_pressed = false;
@@ -49,6 +53,9 @@ void input_poll(InputState* input) {
             case SDLK_F11:
               input->f11_pressed = true;
               break;
+            case SDLK_F3:
+              input->f3_pressed = true;
+              break;
             case SDLK_UP:
               input->up_pressed = true;
               break;
@@ -76,4 +83,5 @@ void input_poll(InputState* input) {
         break;
     }
   }
+  TRACE_END("input_poll");
 }
@@ -0,0 +1,148 @@
+/**
+ * @file profiler.c
+ * @brief Implements the per-frame profiler.
+ *
+ * Zone times are accumulated as raw counter ticks during a frame and converted
+ * to milliseconds once, when the frame is closed. Statistics are only
+ * computed when asked for, so recording a frame stays a handful of adds.
+ */
+
+#include "core/profiler.h"
+
+#ifdef STARFALL_PROFILE
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "utils/constants.h"
+
+/**
+ * @struct Profiler
+ * @brief The profiler's global state.
+ */
+typedef struct {
+  Uint64 current[PROFILE_ZONE_COUNT];  ///< Ticks accumulated this frame.
+  /// Allocations accumulated this frame.
+  AllocCounts current_allocs[PROFILE_ZONE_COUNT];
+  /// Zone times in milliseconds, one row per past frame.
+  float history[PROFILER_HISTORY_FRAMES][PROFILE_ZONE_COUNT];
+  /// Zone allocations, one row per past frame.
+  AllocCounts allocs[PROFILER_HISTORY_FRAMES][PROFILE_ZONE_COUNT];
+  int head;             ///< Next history row to write.
+  int frames;           ///< Rows of history filled so far.
+  Uint64 frames_total;  ///< Frames recorded since startup.
+  double ms_per_tick;   ///< Length of a performance counter tick in ms.
+} Profiler;
+
+static Profiler profiler;
+
+static const char* const ZONE_NAMES[PROFILE_ZONE_COUNT] = {
+    "frame", "input", "world_update", "collisions", "render", "present"};
+
+// --- Private Helpers ---
+
+/**
+ * @brief Orders floats ascending for qsort().
+ */
+static int compare_floats(const void* a, const void* b) {
+  float x = *(const float*)a;
+  float y = *(const float*)b;
+  return (x > y) - (x < y);
+}
+
+// --- Public API Implementations ---
+
+void profiler_init(void) {
+  SDL_memset(&profiler, 0, sizeof(profiler));
+  profiler.ms_per_tick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+void profiler_shutdown(void) {
+  FILE* file = fopen(PROFILER_CSV_PATH, "w");
+  if (!file) {
+    fprintf(stderr, "WARN: Failed to write profile to %s.\n",
+            PROFILER_CSV_PATH);
+    return;
+  }
+
+  fprintf(file, "frame");
+  for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+    fprintf(file, ",%s_ms,%s_allocs,%s_bytes", ZONE_NAMES[z], ZONE_NAMES[z],
+            ZONE_NAMES[z]);
+  }
+  fprintf(file, "\n");
+
+  // Rows are written oldest first and numbered from the start of the run.
+  int oldest = (profiler.head - profiler.frames + PROFILER_HISTORY_FRAMES) %
+               PROFILER_HISTORY_FRAMES;
+  Uint64 first_frame = profiler.frames_total - (Uint64)profiler.frames;
+  for (int f = 0; f < profiler.frames; f++) {
+    int index = (oldest + f) % PROFILER_HISTORY_FRAMES;
+    const float* row = profiler.history[index];
+    const AllocCounts* allocs = profiler.allocs[index];
+    fprintf(file, "%llu", (unsigned long long)(first_frame + (Uint64)f));
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+      fprintf(file, ",%.4f,%u,%u", row[z], (unsigned)allocs[z].count,
+              (unsigned)allocs[z].bytes);
+    }
+    fprintf(file, "\n");
+  }
+  fclose(file);
+  printf("Profile of the last %d frames written to %s.\n", profiler.frames,
+         PROFILER_CSV_PATH);
+}
+
+void profiler_record(ProfileZone zone, Uint64 elapsed, AllocCounts allocs) {
+  profiler.current[zone] += elapsed;
+  profiler.current_allocs[zone].count += allocs.count;
+  profiler.current_allocs[zone].bytes += allocs.bytes;
+}
+
+void profiler_end_frame(void) {
+  float* row = profiler.history[profiler.head];
+  for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+    row[z] = (float)((double)profiler.current[z] * profiler.ms_per_tick);
+    profiler.current[z] = 0;
+    profiler.allocs[profiler.head][z] = profiler.current_allocs[z];
+    profiler.current_allocs[z] = (AllocCounts){0, 0};
+  }
+  profiler.head = (profiler.head + 1) % PROFILER_HISTORY_FRAMES;
+  if (profiler.frames < PROFILER_HISTORY_FRAMES)
+    profiler.frames++;
+  profiler.frames_total++;
+}
+
+int profiler_get_stats(ProfileZone zone, ProfileZoneStats* stats) {
+  static float sorted[PROFILER_HISTORY_FRAMES];
+  int count = profiler.frames;
+  if (count == 0) {
+    *stats = (ProfileZoneStats){0.0f, 0.0f, 0.0f, 0};
+    return 0;
+  }
+
+  double sum = 0.0;
+  stats->max_allocs = 0;
+  for (int f = 0; f < count; f++) {
+    sorted[f] = profiler.history[f][zone];
+    sum += sorted[f];
+    stats->max_allocs =
+        SDL_max(stats->max_allocs, profiler.allocs[f][zone].count);
+  }
+  qsort(sorted, (size_t)count, sizeof(float), compare_floats);
+  stats->min_ms = sorted[0];
+  stats->avg_ms = (float)(sum / count);
+  stats->p99_ms = sorted[(count - 1) * 99 / 100];
+  return count;
+}
+
+AllocCounts profiler_last_allocs(ProfileZone zone) {
+  int last = (profiler.head - 1 + PROFILER_HISTORY_FRAMES) %
+             PROFILER_HISTORY_FRAMES;
+  return profiler.allocs[last][zone];
+}
+
+const char* profiler_zone_name(ProfileZone zone) {
+  return ZONE_NAMES[zone];
+}
+
+#endif  // STARFALL_PROFILE
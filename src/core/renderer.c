@@ -12,27 +12,44 @@
 #include <SDL2/SDL_image.h>
 #include <stdio.h>
 
+#include "core/audio.h"
+#include "core/glyph_atlas.h"
+#include "core/profiler.h"
+#include "core/startup_report.h"
+#include "core/tracer.h"
 #include "utils/constants.h"
 
 // --- Private Helper Prototypes ---
-static void render_text(SDL_Renderer* renderer, TTF_Font* font,
+static void render_text(RendererContext* context, const GlyphAtlas* atlas,
                         const char* text, int x, int y, SDL_Color color,
                         bool centered);
 static void update_viewport(RendererContext* context);
+static bool batch_init(RendererContext* context);
+static void batch_quad(RendererContext* context, float x, float y,
+                       float half_size, SDL_Color color);
+static void batch_flush(RendererContext* context);
+static float interpolate(float previous, float current, float alpha);
 
 // --- Public API Implementations ---
 
-bool renderer_init(RendererContext* context) {
+bool renderer_init(RendererContext* context, bool vsync,
+                   FrameArena* frame_arena) {
+  // Fonts and the background arrive later, from the asset loader.
+  SDL_memset(context, 0, sizeof(*context));
+  context->frame_arena = frame_arena;
+  startup_phase_begin(STARTUP_PHASE_TTF_INIT);
   if (TTF_Init() == -1) {
     fprintf(stderr, "ERROR: Failed to initialize SDL_ttf: %s\n",
             TTF_GetError());
     return false;
   }
+  startup_phase_end(STARTUP_PHASE_TTF_INIT);
 
   char window_title[128];
   snprintf(window_title, sizeof(window_title), "%s - v%s", WINDOW_TITLE,
            GAME_VERSION);
 
+  startup_phase_begin(STARTUP_PHASE_WINDOW);
   context->window = SDL_CreateWindow(window_title, SDL_WINDOWPOS_CENTERED,
                                      SDL_WINDOWPOS_CENTERED, LOGICAL_WIDTH,
                                      LOGICAL_HEIGHT, SDL_WINDOW_RESIZABLE);
@@ -40,17 +57,22 @@ bool renderer_init(RendererContext* context) {
     fprintf(stderr, "ERROR: Failed to create window: %s\n", SDL_GetError());
     return false;
   }
+  startup_phase_end(STARTUP_PHASE_WINDOW);
 
-  context->renderer =
-      SDL_CreateRenderer(context->window, -1,
-                         SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+  Uint32 renderer_flags = SDL_RENDERER_ACCELERATED;
+  if (vsync)
+    renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
+  startup_phase_begin(STARTUP_PHASE_RENDERER);
+  context->renderer = SDL_CreateRenderer(context->window, -1, renderer_flags);
   if (!context->renderer) {
     fprintf(stderr, "ERROR: Failed to create renderer: %s\n", SDL_GetError());
     return false;
   }
+  startup_phase_end(STARTUP_PHASE_RENDERER);
 
   // Create the main game texture. All gameplay rendering will be done to this
   // texture at a fixed logical resolution.
+  startup_phase_begin(STARTUP_PHASE_GAME_TEXTURE);
   context->game_texture = SDL_CreateTexture(
       context->renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
       LOGICAL_WIDTH, LOGICAL_HEIGHT);
@@ -59,44 +81,30 @@ bool renderer_init(RendererContext* context) {
             SDL_GetError());
     return false;
   }
+  startup_phase_end(STARTUP_PHASE_GAME_TEXTURE);
 
   context->is_fullscreen = false;
-
-  // Load all required fonts.
-  context->font_normal =
-      TTF_OpenFont("assets/fonts/Gameplay.ttf", FONT_SIZE_NORMAL);
-  context->font_large =
-      TTF_OpenFont("assets/fonts/Gameplay.ttf", FONT_SIZE_LARGE);
-  context->font_small =
-      TTF_OpenFont("assets/fonts/Gameplay.ttf", FONT_SIZE_SMALL);
-  if (!context->font_normal || !context->font_large || !context->font_small) {
-    fprintf(stderr, "ERROR: Failed to load font: %s\n", TTF_GetError());
-    // Fonts are critical for the UI, so this is a fatal error.
+  context->draw_calls = 0;
+  context->last_draw_calls = 0;
+  context->show_debug = false;
+  if (!batch_init(context))
     return false;
-  }
-
-  // Load background texture.
-  SDL_Surface* bg_surface = IMG_Load("assets/images/background.jpg");
-  if (bg_surface) {
-    context->background_texture =
-        SDL_CreateTextureFromSurface(context->renderer, bg_surface);
-    SDL_FreeSurface(bg_surface);
-  } else {
-    // A missing background is not a fatal error; the game can still run.
-    fprintf(stderr, "WARN: Failed to load background image: %s\n",
-            IMG_GetError());
-  }
 
   update_viewport(context);
   return true;
 }
 
 void renderer_cleanup(RendererContext* context) {
+  glyph_atlas_destroy(&context->atlas_normal);
+  glyph_atlas_destroy(&context->atlas_large);
+  glyph_atlas_destroy(&context->atlas_small);
   SDL_DestroyTexture(context->background_texture);
   SDL_DestroyTexture(context->game_texture);
   TTF_CloseFont(context->font_normal);
   TTF_CloseFont(context->font_large);
   TTF_CloseFont(context->font_small);
+  SDL_free(context->batch_vertices);
+  SDL_free(context->batch_indices);
   SDL_DestroyRenderer(context->renderer);
   SDL_DestroyWindow(context->window);
   TTF_Quit();
@@ -104,6 +112,8 @@ void renderer_cleanup(RendererContext* context) {
 }
 
 void renderer_prepare_frame(RendererContext* context) {
+  context->draw_calls = 0;
+
   // Set the render target to our internal game texture. All subsequent draw
   // calls will render to this texture, not the window.
   SDL_SetRenderTarget(context->renderer, context->game_texture);
@@ -111,14 +121,17 @@ void renderer_prepare_frame(RendererContext* context) {
   // Clear it with a default "space black" color.
   SDL_SetRenderDrawColor(context->renderer, 10, 10, 20, 255);
   SDL_RenderClear(context->renderer);
+  context->draw_calls++;
 
   // Draw the background first, covering the entire logical area.
   if (context->background_texture) {
     SDL_RenderCopy(context->renderer, context->background_texture, NULL, NULL);
+    context->draw_calls++;
   }
 }
 
 void renderer_present_frame(RendererContext* context) {
+  TRACE_BEGIN("renderer_present_frame");
   // Reset the render target back to the window (the default).
   SDL_SetRenderTarget(context->renderer, NULL);
 
@@ -133,77 +146,101 @@ void renderer_present_frame(RendererContext* context) {
   // calculated viewport.
   SDL_RenderCopy(context->renderer, context->game_texture, NULL,
                  &context->viewport);
+  context->draw_calls += 2;
 
-  // Present the final frame to the user.
+  // Present the final frame to the user. With vsync on, this is where the
+  // frame waits for the display.
+  TRACE_BEGIN("SDL_RenderPresent");
   SDL_RenderPresent(context->renderer);
+  TRACE_END("SDL_RenderPresent");
+  context->last_draw_calls = context->draw_calls;
+  TRACE_END("renderer_present_frame");
 }
 
-void renderer_draw_game(RendererContext* context, const World* world) {
+void renderer_draw_game(RendererContext* context, const World* world,
+                        float alpha) {
+  TRACE_BEGIN("renderer_draw_game");
+  // Every entity is queued as a colored quad and the whole scene is
+  // submitted in as few draw calls as the batch size allows. Quads are drawn
+  // in queue order, so the layering below is preserved.
+
   // Draw projectiles first, so they appear behind other entities.
-  for (int i = 0; i < MAX_PROJECTILES; i++) {
-    if (world->projectiles[i].active) {
-      const Projectile* p = &world->projectiles[i];
-      SDL_SetRenderDrawColor(context->renderer, p->color.r, p->color.g,
-                             p->color.b, 255);
-      SDL_Rect rect = {(int)p->x - p->radius, (int)p->y - p->radius,
-                       p->radius * 2, p->radius * 2};
-      SDL_RenderFillRect(context->renderer, &rect);
-    }
+  const ProjectilePool* projectiles = &world->projectiles;
+  float pr = (float)projectiles->radius;
+  for (int i = 0; i < projectiles->slots.count; i++) {
+    float x = interpolate(projectiles->prev_x[i], projectiles->x[i], alpha);
+    float y = interpolate(projectiles->prev_y[i], projectiles->y[i], alpha);
+    batch_quad(context, x, y, pr, projectiles->color[i]);
   }
 
   // Draw enemies.
-  SDL_SetRenderDrawColor(context->renderer, 255, 0, 0, 255);
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (world->enemies[i].active) {
-      const Enemy* e = &world->enemies[i];
-      SDL_Rect rect = {(int)e->x - e->radius, (int)e->y - e->radius,
-                       e->radius * 2, e->radius * 2};
-      SDL_RenderFillRect(context->renderer, &rect);
-    }
+  const EnemyPool* enemies = &world->enemies;
+  float er = (float)enemies->radius;
+  SDL_Color enemy_color = {255, 0, 0, 255};
+  for (int i = 0; i < enemies->slots.count; i++) {
+    float x = interpolate(enemies->prev_x[i], enemies->x[i], alpha);
+    float y = interpolate(enemies->prev_y[i], enemies->y[i], alpha);
+    batch_quad(context, x, y, er, enemy_color);
   }
 
   // Draw player last, so it appears on top.
-  SDL_SetRenderDrawColor(context->renderer, 0, 255, 0, 255);
-  SDL_Rect player_rect = {(int)world->player.x - world->player.radius,
-                          (int)world->player.y - world->player.radius,
-                          world->player.radius * 2, world->player.radius * 2};
-  SDL_RenderFillRect(context->renderer, &player_rect);
+  const Player* player = &world->player;
+  batch_quad(context, interpolate(player->prev_x, player->x, alpha),
+             interpolate(player->prev_y, player->y, alpha),
+             (float)player->radius, (SDL_Color){0, 255, 0, 255});
+  batch_flush(context);
+  TRACE_END("renderer_draw_game");
 }
 
 void renderer_draw_hud(RendererContext* context, const World* world) {
   SDL_Color white = {255, 255, 255, 255};
-  char buffer[64];
 
   // Draw score on the top-left.
-  snprintf(buffer, sizeof(buffer), "Score: %d", world->score);
-  render_text(context->renderer, context->font_normal, buffer, 10, 10, white,
-              false);
+  char* text =
+      frame_arena_printf(context->frame_arena, "Score: %d", world->score);
+  render_text(context, &context->atlas_normal, text, 10, 10, white, false);
 
   // Draw lives on the top-right.
-  snprintf(buffer, sizeof(buffer), "Lives: %d", world->player.lives);
-  int w, h;
-  TTF_SizeText(context->font_normal, buffer, &w, &h);
-  render_text(context->renderer, context->font_normal, buffer,
-              LOGICAL_WIDTH - w - 10, 10, white, false);
+  text = frame_arena_printf(context->frame_arena, "Lives: %d",
+                            world->player.lives);
+  if (text) {
+    int w, h;
+    glyph_atlas_measure(&context->atlas_normal, text, &w, &h);
+    render_text(context, &context->atlas_normal, text, LOGICAL_WIDTH - w - 10,
+                10, white, false);
+  }
 }
 
 void renderer_draw_menu(RendererContext* context, int selected_option) {
   SDL_Color white = {255, 255, 255, 255};
   SDL_Color green = {0, 255, 0, 255};  // Highlight color for selected option.
 
-  render_text(context->renderer, context->font_large, "Starfall 2D",
+  render_text(context, &context->atlas_large, "Starfall 2D",
               LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 4, white, true);
-  render_text(context->renderer, context->font_normal, "Play",
+  render_text(context, &context->atlas_normal, "Play",
               LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 2,
               selected_option == 0 ? green : white, true);
-  render_text(context->renderer, context->font_normal, "Exit",
+  render_text(context, &context->atlas_normal, "Exit",
               LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 2 + 40,
               selected_option == 1 ? green : white, true);
-  render_text(context->renderer, context->font_small,
+  render_text(context, &context->atlas_small,
               "Use ARROWS/ENTER or MOUSE", LOGICAL_WIDTH / 2,
               LOGICAL_HEIGHT - 30, white, true);
 }
 
+void renderer_draw_loading(RendererContext* context, float progress) {
+  // No font may be loaded yet, so the progress is shown as a bar only.
+  SDL_Rect frame = {LOGICAL_WIDTH / 4, LOGICAL_HEIGHT / 2 - 8,
+                    LOGICAL_WIDTH / 2, 16};
+  SDL_Rect bar = {frame.x + 2, frame.y + 2,
+                  (int)((float)(frame.w - 4) * SDL_clamp(progress, 0.0f, 1.0f)),
+                  frame.h - 4};
+  SDL_SetRenderDrawColor(context->renderer, 255, 255, 255, 255);
+  SDL_RenderDrawRect(context->renderer, &frame);
+  SDL_RenderFillRect(context->renderer, &bar);
+  context->draw_calls += 2;
+}
+
 void renderer_draw_game_over(RendererContext* context, const World* world,
                              int selected_option) {
   // Draw a semi-transparent overlay to dim the background.
@@ -211,24 +248,76 @@ void renderer_draw_game_over(RendererContext* context, const World* world,
   SDL_SetRenderDrawColor(context->renderer, 0, 0, 0, 180);
   SDL_Rect overlay = {0, 0, LOGICAL_WIDTH, LOGICAL_HEIGHT};
   SDL_RenderFillRect(context->renderer, &overlay);
+  context->draw_calls++;
 
   SDL_Color white = {255, 255, 255, 255};
   SDL_Color green = {0, 255, 0, 255};
-  char score_text[64];
-  snprintf(score_text, sizeof(score_text), "Final Score: %d", world->score);
+  char* score_text = frame_arena_printf(context->frame_arena,
+                                        "Final Score: %d", world->score);
 
-  render_text(context->renderer, context->font_large, "Game Over",
+  render_text(context, &context->atlas_large, "Game Over",
               LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 4, white, true);
-  render_text(context->renderer, context->font_normal, score_text,
+  render_text(context, &context->atlas_normal, score_text,
               LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 4 + 60, white, true);
-  render_text(context->renderer, context->font_normal, "Restart",
+  render_text(context, &context->atlas_normal, "Restart",
               LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 2 + 40,
               selected_option == 0 ? green : white, true);
-  render_text(context->renderer, context->font_normal, "Main Menu",
+  render_text(context, &context->atlas_normal, "Main Menu",
               LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 2 + 80,
               selected_option == 1 ? green : white, true);
 }
 
+void renderer_draw_debug(RendererContext* context, const AudioContext* audio) {
+  SDL_Color yellow = {255, 255, 0, 255};
+  FrameArena* arena = context->frame_arena;
+  int line_height = context->atlas_small.line_height;
+  char* text = frame_arena_printf(arena, "Draw calls: %d",
+                                  context->last_draw_calls);
+  render_text(context, &context->atlas_small, text, 10, LOGICAL_HEIGHT - 26,
+              yellow, false);
+  const AudioLatency* latency = &audio->latency;
+  text = frame_arena_printf(
+      arena, "Audio: %d frames, %.1f ms%s, %llu underruns",
+      latency->buffer_frames, audio_latency_ms(audio),
+      latency->adaptive ? " (auto)" : "",
+      (unsigned long long)latency->total_underruns);
+  render_text(context, &context->atlas_small, text, 10,
+              LOGICAL_HEIGHT - 26 - line_height, yellow, false);
+  // Measured before this line is formatted, which adds a few bytes.
+  text = frame_arena_printf(
+      arena, "Frame arena: %llu / %llu bytes, peak %llu",
+      (unsigned long long)frame_arena_used(arena),
+      (unsigned long long)arena->buffers[arena->current].capacity,
+      (unsigned long long)arena->high_water);
+  render_text(context, &context->atlas_small, text, 10,
+              LOGICAL_HEIGHT - 26 - 2 * line_height, yellow, false);
+
+#ifdef STARFALL_PROFILE
+  // Per-zone frame times over the profiler history, above the draw calls,
+  // the audio latency and the frame arena.
+  int y = LOGICAL_HEIGHT - 26 - (PROFILE_ZONE_COUNT + 3) * line_height;
+  int frames = 0;
+  bool allocs = alloc_tracker_installed();
+  for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+    ProfileZoneStats stats;
+    frames = profiler_get_stats((ProfileZone)z, &stats);
+    const char* name = profiler_zone_name((ProfileZone)z);
+    text = allocs ? frame_arena_printf(arena, "%-13s %6.2f %6.2f %6.2f %6u",
+                                       name, stats.min_ms, stats.avg_ms,
+                                       stats.p99_ms,
+                                       (unsigned)stats.max_allocs)
+                  : frame_arena_printf(arena, "%-13s %6.2f %6.2f %6.2f", name,
+                                       stats.min_ms, stats.avg_ms,
+                                       stats.p99_ms);
+    render_text(context, &context->atlas_small, text, 10,
+                y + (z + 1) * line_height, yellow, false);
+  }
+  text = frame_arena_printf(arena, "ms over %d frames: min avg p99%s", frames,
+                            allocs ? ", max allocs" : "");
+  render_text(context, &context->atlas_small, text, 10, y, yellow, false);
+#endif
+}
+
 void renderer_toggle_fullscreen(RendererContext* context) {
   context->is_fullscreen = !context->is_fullscreen;
   Uint32 flags = context->is_fullscreen ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0;
@@ -237,11 +326,11 @@ void renderer_toggle_fullscreen(RendererContext* context) {
 
 SDL_Rect renderer_get_text_rect(RendererContext* context, const char* text,
                                 int x, int y) {
-  if (!context->font_normal)
+  if (!context->atlas_normal.texture)
     return (SDL_Rect){0, 0, 0, 0};
   int w, h;
   // Use the normal font for button hitboxes for consistency.
-  TTF_SizeText(context->font_normal, text, &w, &h);
+  glyph_atlas_measure(&context->atlas_normal, text, &w, &h);
   return (SDL_Rect){x - w / 2, y - h / 2, w, h};
 }
 
@@ -273,8 +362,9 @@ void renderer_window_to_logical(RendererContext* context, int window_x,
 
 /**
  * @brief Renders a text string to the current render target.
- * @param renderer The active SDL_Renderer.
- * @param font The TTF_Font to use for rendering.
+ * @param context A pointer to the RendererContext, for the renderer and the
+ * draw call counter.
+ * @param atlas The glyph atlas of the font to render with.
  * @param text The null-terminated string to render.
  * @param x The target X coordinate.
  * @param y The target Y coordinate.
@@ -282,27 +372,105 @@ void renderer_window_to_logical(RendererContext* context, int window_x,
  * @param centered If true, (x,y) is the center point; otherwise, it's the
  * top-left corner.
  */
-static void render_text(SDL_Renderer* renderer, TTF_Font* font,
+static void render_text(RendererContext* context, const GlyphAtlas* atlas,
                         const char* text, int x, int y, SDL_Color color,
                         bool centered) {
-  if (!font || !text)
-    return;
-  SDL_Surface* surface = TTF_RenderText_Blended(font, text, color);
-  if (!surface)
+  if (!text)
     return;
-  SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-  if (!texture) {
-    SDL_FreeSurface(surface);
-    return;
-  }
-  SDL_Rect dest_rect = {x, y, surface->w, surface->h};
+  TRACE_BEGIN("render_text");
   if (centered) {
-    dest_rect.x -= surface->w / 2;
-    dest_rect.y -= surface->h / 2;
+    int w, h;
+    glyph_atlas_measure(atlas, text, &w, &h);
+    x -= w / 2;
+    y -= h / 2;
   }
-  SDL_RenderCopy(renderer, texture, NULL, &dest_rect);
-  SDL_DestroyTexture(texture);
-  SDL_FreeSurface(surface);
+  context->draw_calls +=
+      glyph_atlas_draw(atlas, context->renderer, text, (float)x, (float)y,
+                       color);
+  TRACE_END("render_text");
+}
+
+/**
+ * @brief Allocates the entity batch and fills in its constant index pattern.
+ * @param context A pointer to the RendererContext.
+ * @return true on success, false if the buffers could not be allocated.
+ */
+static bool batch_init(RendererContext* context) {
+  context->batch_vertices =
+      SDL_malloc(sizeof(SDL_Vertex) * RENDER_BATCH_QUADS * 4);
+  context->batch_indices = SDL_malloc(sizeof(int) * RENDER_BATCH_QUADS * 6);
+  context->batch_quads = 0;
+  if (!context->batch_vertices || !context->batch_indices) {
+    fprintf(stderr, "ERROR: Failed to allocate the render batch.\n");
+    return false;
+  }
+
+  // Every quad is two triangles over its four corners, so the index buffer
+  // never changes and is written once here.
+  for (int q = 0; q < RENDER_BATCH_QUADS; q++) {
+    int base = q * 4;
+    int* quad = &context->batch_indices[q * 6];
+    quad[0] = base;
+    quad[1] = base + 1;
+    quad[2] = base + 2;
+    quad[3] = base + 2;
+    quad[4] = base + 3;
+    quad[5] = base;
+  }
+  return true;
+}
+
+/**
+ * @brief Queues a solid square centered on a point, skipping it if it lies
+ * entirely outside the logical screen.
+ * @param context A pointer to the RendererContext.
+ * @param x The X coordinate of the square's center.
+ * @param y The Y coordinate of the square's center.
+ * @param half_size Half the side length of the square.
+ * @param color The fill color of the square.
+ */
+static void batch_quad(RendererContext* context, float x, float y,
+                       float half_size, SDL_Color color) {
+  // Enemies spawn and projectiles linger just off-screen; drawing them would
+  // only cost vertices.
+  float x0 = x - half_size, y0 = y - half_size;
+  float x1 = x + half_size, y1 = y + half_size;
+  if (x1 < 0.0f || y1 < 0.0f || x0 > LOGICAL_WIDTH || y0 > LOGICAL_HEIGHT)
+    return;
+
+  if (context->batch_quads == RENDER_BATCH_QUADS)
+    batch_flush(context);
+  SDL_Vertex* quad = &context->batch_vertices[context->batch_quads * 4];
+  quad[0] = (SDL_Vertex){{x0, y0}, color, {0.0f, 0.0f}};
+  quad[1] = (SDL_Vertex){{x1, y0}, color, {0.0f, 0.0f}};
+  quad[2] = (SDL_Vertex){{x1, y1}, color, {0.0f, 0.0f}};
+  quad[3] = (SDL_Vertex){{x0, y1}, color, {0.0f, 0.0f}};
+  context->batch_quads++;
+}
+
+/**
+ * @brief Submits every queued quad in a single draw call.
+ * @param context A pointer to the RendererContext.
+ */
+static void batch_flush(RendererContext* context) {
+  if (context->batch_quads == 0)
+    return;
+  SDL_RenderGeometry(context->renderer, NULL, context->batch_vertices,
+                     context->batch_quads * 4, context->batch_indices,
+                     context->batch_quads * 6);
+  context->draw_calls++;
+  context->batch_quads = 0;
+}
+
+/**
+ * @brief Blends a coordinate between two simulation ticks.
+ * @param previous The value at the previous tick.
+ * @param current The value at the latest tick.
+ * @param alpha The blend factor, from 0.0 (previous) to 1.0 (current).
+ * @return The interpolated value.
+ */
+static float interpolate(float previous, float current, float alpha) {
+  return previous + (current - previous) * alpha;
 }
 
 /**
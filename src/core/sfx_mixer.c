@@ -0,0 +1,191 @@
+/**
+ * @file sfx_mixer.c
+ * @brief Implements the software sound effect mixer.
+ *
+ * Each callback is mixed in blocks of SFX_MIX_BLOCK_FRAMES frames, so the
+ * float accumulator stays small enough to live in L1. Every voice is
+ * converted from 16-bit, scaled and summed into the accumulator, which is
+ * then added to the stream and rounded back to 16 bits with saturation. The
+ * SSE2 kernels handle eight samples per iteration; a scalar version covers
+ * the tails and non-x86 targets.
+ *
+ * The command ring's indices only ever grow and are reduced modulo the ring
+ * size when used. SDL_AtomicSet() and SDL_AtomicGet() are full barriers, so
+ * a command's contents are visible before the index that publishes it.
+ */
+
+#include "core/sfx_mixer.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "core/tracer.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SFX_HAVE_SSE2 1
+#endif
+
+// --- Private Helpers ---
+
+/**
+ * @brief Adds scaled 16-bit samples to the accumulator.
+ * @param mix The float accumulator.
+ * @param samples The samples to add.
+ * @param count The number of samples (twice the frames).
+ * @param gain The linear volume to scale the samples by.
+ */
+static void mix_add(float* mix, const Sint16* samples, int count,
+                    float gain) {
+  int i = 0;
+#if defined(SFX_HAVE_SSE2)
+  __m128 scale = _mm_set1_ps(gain);
+  for (; i + 8 <= count; i += 8) {
+    __m128i packed = _mm_loadu_si128((const __m128i*)(samples + i));
+    // Widen to 32 bits by placing each sample in the high half of a lane and
+    // shifting it back down with sign extension.
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+    _mm_storeu_ps(mix + i, _mm_add_ps(_mm_loadu_ps(mix + i),
+                                      _mm_mul_ps(_mm_cvtepi32_ps(lo), scale)));
+    _mm_storeu_ps(mix + i + 4,
+                  _mm_add_ps(_mm_loadu_ps(mix + i + 4),
+                             _mm_mul_ps(_mm_cvtepi32_ps(hi), scale)));
+  }
+#endif
+  for (; i < count; i++) {
+    mix[i] += (float)samples[i] * gain;
+  }
+}
+
+/**
+ * @brief Adds the accumulator to a stream, saturating at the 16-bit limits.
+ * @param stream The samples to add to.
+ * @param mix The float accumulator.
+ * @param count The number of samples (twice the frames).
+ */
+static void mix_store(Sint16* stream, const float* mix, int count) {
+  int i = 0;
+#if defined(SFX_HAVE_SSE2)
+  for (; i + 8 <= count; i += 8) {
+    // Add in float, then round and pack back to 16 bits with saturation.
+    __m128i packed = _mm_loadu_si128((const __m128i*)(stream + i));
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+    lo = _mm_cvtps_epi32(
+        _mm_add_ps(_mm_cvtepi32_ps(lo), _mm_loadu_ps(mix + i)));
+    hi = _mm_cvtps_epi32(
+        _mm_add_ps(_mm_cvtepi32_ps(hi), _mm_loadu_ps(mix + i + 4)));
+    _mm_storeu_si128((__m128i*)(stream + i), _mm_packs_epi32(lo, hi));
+  }
+#endif
+  for (; i < count; i++) {
+    float value = (float)stream[i] + mix[i];
+    stream[i] = (Sint16)lrintf(SDL_clamp(value, -32768.0f, 32767.0f));
+  }
+}
+
+/**
+ * @brief Starts a voice, replacing the oldest one if every voice is busy.
+ * @param mixer A pointer to the SfxMixer.
+ * @param command A constant pointer to the command to start.
+ */
+static void start_voice(SfxMixer* mixer, const SfxCommand* command) {
+  const SfxSound* sound = &mixer->sounds[command->sound];
+  if (!sound->samples || sound->frames <= 0)
+    return;
+  SfxVoice* voice;
+  if (mixer->voice_count < SFX_MAX_VOICES) {
+    voice = &mixer->voices[mixer->voice_count++];
+  } else {
+    voice = &mixer->voices[0];
+    for (int v = 1; v < mixer->voice_count; v++) {
+      if (mixer->voices[v].started < voice->started)
+        voice = &mixer->voices[v];
+    }
+    mixer->stolen++;
+  }
+  voice->samples = sound->samples;
+  voice->frames = sound->frames;
+  voice->position = 0;
+  voice->gain = command->gain;
+  voice->started = mixer->next_voice++;
+  mixer->started++;
+}
+
+/**
+ * @brief Starts every command queued since the last call.
+ * @param mixer A pointer to the SfxMixer.
+ */
+static void drain_commands(SfxMixer* mixer) {
+  Uint32 head = (Uint32)SDL_AtomicGet(&mixer->command_head);
+  Uint32 tail = (Uint32)SDL_AtomicGet(&mixer->command_tail);
+  for (; tail != head; tail++) {
+    start_voice(mixer, &mixer->commands[tail & (SFX_COMMAND_RING - 1)]);
+  }
+  SDL_AtomicSet(&mixer->command_tail, (int)tail);
+}
+
+// --- Public API Implementations ---
+
+void sfx_mixer_init(SfxMixer* mixer) {
+  memset(mixer, 0, sizeof(*mixer));
+}
+
+void sfx_mixer_set_sound(SfxMixer* mixer, int sound, const Sint16* samples,
+                         int frames) {
+  if (sound < 0 || sound >= SFX_MAX_SOUNDS)
+    return;
+  mixer->sounds[sound].samples = samples;
+  mixer->sounds[sound].frames = frames;
+}
+
+bool sfx_mixer_play(SfxMixer* mixer, int sound, float gain) {
+  if (sound < 0 || sound >= SFX_MAX_SOUNDS)
+    return false;
+  Uint32 head = (Uint32)SDL_AtomicGet(&mixer->command_head);
+  Uint32 tail = (Uint32)SDL_AtomicGet(&mixer->command_tail);
+  if (head - tail >= SFX_COMMAND_RING)
+    return false;
+  SfxCommand* command = &mixer->commands[head & (SFX_COMMAND_RING - 1)];
+  command->sound = sound;
+  command->gain = gain;
+  SDL_AtomicSet(&mixer->command_head, (int)(head + 1));
+  return true;
+}
+
+void sfx_mixer_mix(SfxMixer* mixer, Sint16* stream, int frames) {
+  drain_commands(mixer);
+  if (mixer->voice_count == 0)
+    return;
+  TRACE_BEGIN("sfx_mixer_mix");
+  for (int done = 0; done < frames; done += SFX_MIX_BLOCK_FRAMES) {
+    int block = SDL_min(SFX_MIX_BLOCK_FRAMES, frames - done);
+    memset(mixer->mix, 0, sizeof(float) * 2 * (size_t)block);
+    for (int v = 0; v < mixer->voice_count;) {
+      SfxVoice* voice = &mixer->voices[v];
+      int count = SDL_min(block, voice->frames - voice->position);
+      mix_add(mixer->mix, voice->samples + 2 * voice->position, 2 * count,
+              voice->gain);
+      voice->position += count;
+      if (voice->position >= voice->frames) {
+        // Swap the last voice in; it has not been mixed into this block yet.
+        *voice = mixer->voices[--mixer->voice_count];
+        continue;
+      }
+      v++;
+    }
+    mix_store(stream + 2 * done, mixer->mix, 2 * block);
+    if (mixer->voice_count == 0)
+      break;
+  }
+  TRACE_END("sfx_mixer_mix");
+}
+
+const char* sfx_mixer_kernel_name(void) {
+#if defined(SFX_HAVE_SSE2)
+  return "SSE2";
+#else
+  return "scalar";
+#endif
+}
@@ -0,0 +1,145 @@
+/**
+ * @file startup_report.c
+ * @brief Implements the startup and shutdown phase timing.
+ *
+ * Every phase owns one slot that is written by the thread that runs it, so
+ * recording needs no locking. The startup report reads the loader's slots
+ * only after the loader thread was joined.
+ */
+
+#include "core/startup_report.h"
+
+#include <stdio.h>
+
+/**
+ * @struct StartupTiming
+ * @brief When one phase began and ended.
+ */
+typedef struct {
+  Uint64 begin;  ///< Performance counter when the phase began.
+  Uint64 end;    ///< Performance counter when it ended; 0 while running.
+} StartupTiming;
+
+/**
+ * @struct StartupReport
+ * @brief The startup report's global state.
+ */
+typedef struct {
+  Uint64 origin;                              ///< Counter at launch.
+  double ms_per_tick;                         ///< Length of a counter tick.
+  StartupTiming phases[STARTUP_PHASE_COUNT];  ///< One per phase.
+} StartupReport;
+
+static StartupReport report;
+
+static const char* const PHASE_NAMES[STARTUP_PHASE_COUNT] = {
+    [STARTUP_PHASE_SDL_INIT] = "SDL_Init",
+    [STARTUP_PHASE_ASSET_PACK] = "asset archive",
+    [STARTUP_PHASE_TTF_INIT] = "TTF_Init",
+    [STARTUP_PHASE_WINDOW] = "window",
+    [STARTUP_PHASE_RENDERER] = "renderer",
+    [STARTUP_PHASE_GAME_TEXTURE] = "game texture",
+    [STARTUP_PHASE_OPEN_AUDIO] = "Mix_OpenAudio",
+    [STARTUP_PHASE_WORLD] = "world",
+    [STARTUP_PHASE_THREAD_POOL] = "thread pool",
+    [STARTUP_PHASE_FONT_NORMAL] = "font (normal)",
+    [STARTUP_PHASE_FONT_LARGE] = "font (large)",
+    [STARTUP_PHASE_FONT_SMALL] = "font (small)",
+    [STARTUP_PHASE_BACKGROUND] = "background image",
+    [STARTUP_PHASE_SOUNDS] = "sound effects",
+    [STARTUP_PHASE_MUSIC] = "music",
+    [STARTUP_PHASE_FIRST_FRAME] = "first frame",
+    [STARTUP_PHASE_LOADED_FRAME] = "first loaded frame",
+    [STARTUP_PHASE_SHUTDOWN] = "total",
+    [STARTUP_PHASE_STOP_LOADER] = "asset loader",
+    [STARTUP_PHASE_STOP_WORKERS] = "thread pool",
+    [STARTUP_PHASE_FREE_WORLD] = "world",
+    [STARTUP_PHASE_CLOSE_RENDERER] = "renderer",
+    [STARTUP_PHASE_CLOSE_AUDIO] = "audio",
+    [STARTUP_PHASE_SDL_QUIT] = "SDL_Quit",
+};
+
+// --- Private Helpers ---
+
+/**
+ * @brief Converts a span of performance counter ticks to milliseconds.
+ * @param ticks The span.
+ * @return The span in milliseconds.
+ */
+static double ticks_to_ms(Uint64 ticks) {
+  return (double)ticks * report.ms_per_tick;
+}
+
+/**
+ * @brief Prints one phase as a row of the startup table.
+ * @param phase The phase to print; skipped if it never ran to its end.
+ * @param thread Where the phase ran.
+ */
+static void print_startup_row(StartupPhase phase, const char* thread) {
+  const StartupTiming* timing = &report.phases[phase];
+  if (timing->end == 0)
+    return;
+  printf("  %-20s %10.1f %10.1f  %s\n", PHASE_NAMES[phase],
+         ticks_to_ms(timing->begin - report.origin),
+         ticks_to_ms(timing->end - timing->begin), thread);
+}
+
+/**
+ * @brief Prints one phase as a row of the shutdown table.
+ * @param phase The phase to print; skipped if it never ran to its end.
+ */
+static void print_shutdown_row(StartupPhase phase) {
+  const StartupTiming* timing = &report.phases[phase];
+  if (timing->end == 0)
+    return;
+  printf("  %-20s %10.1f\n", PHASE_NAMES[phase],
+         ticks_to_ms(timing->end - timing->begin));
+}
+
+// --- Public API Implementations ---
+
+void startup_report_init(void) {
+  SDL_memset(&report, 0, sizeof(report));
+  report.ms_per_tick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+  report.origin = SDL_GetPerformanceCounter();
+}
+
+void startup_phase_begin(StartupPhase phase) {
+  report.phases[phase].begin = SDL_GetPerformanceCounter();
+  report.phases[phase].end = 0;
+}
+
+void startup_phase_end(StartupPhase phase) {
+  report.phases[phase].end = SDL_GetPerformanceCounter();
+}
+
+void startup_phase_mark(StartupPhase phase) {
+  report.phases[phase].begin = report.phases[phase].end =
+      SDL_GetPerformanceCounter();
+}
+
+void startup_report_print_startup(void) {
+  printf("Startup (ms):\n");
+  printf("  %-20s %10s %10s  %s\n", "phase", "start", "duration", "thread");
+  for (int phase = 0; phase < STARTUP_PHASE_FONT_NORMAL; phase++) {
+    print_startup_row((StartupPhase)phase, "main");
+  }
+  for (int phase = STARTUP_PHASE_FONT_NORMAL;
+       phase < STARTUP_PHASE_FIRST_FRAME; phase++) {
+    print_startup_row((StartupPhase)phase, "loader");
+  }
+  for (int phase = STARTUP_PHASE_FIRST_FRAME; phase < STARTUP_PHASE_SHUTDOWN;
+       phase++) {
+    print_startup_row((StartupPhase)phase, "main");
+  }
+}
+
+void startup_report_print_shutdown(void) {
+  printf("Shutdown (ms):\n");
+  for (int phase = STARTUP_PHASE_SHUTDOWN + 1; phase < STARTUP_PHASE_COUNT;
+       phase++) {
+    print_shutdown_row((StartupPhase)phase);
+  }
+  // The total goes last, under the steps it adds up.
+  print_shutdown_row(STARTUP_PHASE_SHUTDOWN);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file thread_pool.c
+ * @brief Implements the worker thread pool.
+ *
+ * Workers sleep on a semaphore between loops. A loop is published by filling
+ * in the pool's task fields and posting the start semaphore once per worker;
+ * the semaphores also order the memory accesses, so the workers see the
+ * task and the caller sees everything the workers wrote.
+ */
+
+#include "core/thread_pool.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "core/tracer.h"
+
+// --- Private Helpers ---
+
+/**
+ * @brief Claims the next chunk of a queue.
+ * @param queue A pointer to the queue to claim from.
+ * @return The chunk index, or -1 if the queue is empty.
+ */
+static int claim_chunk(ThreadPoolQueue* queue) {
+  if (SDL_AtomicGet(&queue->next) >= queue->end)
+    return -1;
+  int chunk = SDL_AtomicAdd(&queue->next, 1);
+  return chunk < queue->end ? chunk : -1;
+}
+
+/**
+ * @brief Runs one chunk of the current loop.
+ * @param pool A pointer to the ThreadPool.
+ * @param chunk The index of the chunk to run.
+ */
+static void run_chunk(ThreadPool* pool, int chunk) {
+  int begin = chunk * pool->chunk_size;
+  int end = SDL_min(begin + pool->chunk_size, pool->count);
+  pool->task(pool->context, begin, end);
+}
+
+/**
+ * @brief Works through a thread's own queue, then steals from the others.
+ * @param pool A pointer to the ThreadPool.
+ * @param index The index of the calling thread's queue.
+ */
+static void work(ThreadPool* pool, int index) {
+  TRACE_BEGIN("thread_pool_work");
+  for (int k = 0; k < pool->thread_count; k++) {
+    // Visit our own queue first, then the others in a fixed rotation so
+    // thieves spread out over different victims.
+    ThreadPoolQueue* queue = &pool->queues[(index + k) % pool->thread_count];
+    int chunk;
+    while ((chunk = claim_chunk(queue)) >= 0) {
+      run_chunk(pool, chunk);
+    }
+  }
+  TRACE_END("thread_pool_work");
+}
+
+/**
+ * @brief The main function of every worker thread.
+ * @param data A pointer to the thread's ThreadPoolWorker.
+ * @return Always 0.
+ */
+static int worker_main(void* data) {
+  ThreadPoolWorker* worker = data;
+  ThreadPool* pool = worker->pool;
+  for (;;) {
+    SDL_SemWait(pool->start);
+    if (SDL_AtomicGet(&pool->quit))
+      break;
+    work(pool, worker->index);
+    SDL_SemPost(pool->done);
+  }
+  return 0;
+}
+
+// --- Public API Implementations ---
+
+bool thread_pool_init(ThreadPool* pool, int thread_count) {
+  memset(pool, 0, sizeof(*pool));
+  if (thread_count <= 0)
+    thread_count = SDL_GetCPUCount();
+  pool->thread_count = SDL_clamp(thread_count, 1, THREAD_POOL_MAX_THREADS);
+
+  pool->start = SDL_CreateSemaphore(0);
+  pool->done = SDL_CreateSemaphore(0);
+  if (!pool->start || !pool->done) {
+    fprintf(stderr, "ERROR: Failed to create thread pool semaphores: %s\n",
+            SDL_GetError());
+    thread_pool_destroy(pool);
+    return false;
+  }
+
+  // Worker 0 is whichever thread calls thread_pool_parallel_for().
+  pool->workers[0].pool = pool;
+  for (int i = 1; i < pool->thread_count; i++) {
+    ThreadPoolWorker* worker = &pool->workers[i];
+    worker->pool = pool;
+    worker->index = i;
+    worker->thread = SDL_CreateThread(worker_main, "starfall-worker", worker);
+    if (!worker->thread) {
+      fprintf(stderr, "ERROR: Failed to create worker thread: %s\n",
+              SDL_GetError());
+      pool->thread_count = i;
+      thread_pool_destroy(pool);
+      return false;
+    }
+  }
+  return true;
+}
+
+void thread_pool_destroy(ThreadPool* pool) {
+  SDL_AtomicSet(&pool->quit, 1);
+  for (int i = 1; i < pool->thread_count; i++) {
+    SDL_SemPost(pool->start);
+  }
+  for (int i = 1; i < pool->thread_count; i++) {
+    if (pool->workers[i].thread)
+      SDL_WaitThread(pool->workers[i].thread, NULL);
+    pool->workers[i].thread = NULL;
+  }
+  if (pool->start)
+    SDL_DestroySemaphore(pool->start);
+  if (pool->done)
+    SDL_DestroySemaphore(pool->done);
+  pool->start = NULL;
+  pool->done = NULL;
+  pool->thread_count = 1;
+}
+
+void thread_pool_parallel_for(ThreadPool* pool, int count, int chunk_size,
+                              ThreadPoolTask task, void* context) {
+  int chunks = (count + chunk_size - 1) / chunk_size;
+  if (!pool || pool->thread_count == 1 || chunks <= 1) {
+    for (int c = 0; c < chunks; c++) {
+      task(context, c * chunk_size, SDL_min((c + 1) * chunk_size, count));
+    }
+    return;
+  }
+
+  pool->task = task;
+  pool->context = context;
+  pool->count = count;
+  pool->chunk_size = chunk_size;
+
+  // Give every thread an even, contiguous share of the chunks; threads
+  // beyond the number of chunks start with an empty queue and only steal.
+  int workers = pool->thread_count;
+  for (int i = 0; i < workers; i++) {
+    SDL_AtomicSet(&pool->queues[i].next, chunks * i / workers);
+    pool->queues[i].end = chunks * (i + 1) / workers;
+  }
+
+  for (int i = 1; i < workers; i++) {
+    SDL_SemPost(pool->start);
+  }
+  work(pool, 0);
+  for (int i = 1; i < workers; i++) {
+    SDL_SemWait(pool->done);
+  }
+}
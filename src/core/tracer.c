@@ -0,0 +1,132 @@
+/**
+ * @file tracer.c
+ * @brief Implements the trace-event recorder and its JSON export.
+ *
+ * Events store the raw performance counter; timestamps are converted to
+ * microseconds, the unit of the trace-event format, only when the file is
+ * written.
+ */
+
+#include "core/tracer.h"
+
+#include <stdio.h>
+
+#include "utils/constants.h"
+
+/**
+ * @struct TraceEvent
+ * @brief One recorded begin or end event.
+ */
+typedef struct {
+  const char* name;        ///< Span name (a string literal).
+  Uint64 timestamp;        ///< SDL_GetPerformanceCounter() at the event.
+  SDL_threadID thread_id;  ///< Thread that recorded the event.
+  char phase;              ///< 'B' (begin) or 'E' (end).
+} TraceEvent;
+
+/**
+ * @struct Tracer
+ * @brief The tracer's global state.
+ */
+typedef struct {
+  TraceEvent* events;          ///< Preallocated event buffer.
+  SDL_atomic_t next;           ///< Index of the next free slot.
+  SDL_atomic_t dropped;        ///< Events lost because the buffer was full.
+  Uint64 start;                ///< Counter value at tracer_init().
+  SDL_threadID main_thread;    ///< Thread that called tracer_init().
+  char path[MAX_PATH_LENGTH];  ///< Output file.
+} Tracer;
+
+SDL_atomic_t tracer_enabled;
+
+static Tracer tracer;
+
+// --- Private Helpers ---
+
+/**
+ * @brief Writes the recorded events as a trace-event JSON document.
+ * @param file The open output file.
+ * @param count The number of valid events in the buffer.
+ */
+static void write_events(FILE* file, int count) {
+  double us_per_tick = 1e6 / (double)SDL_GetPerformanceFrequency();
+
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  // Name the main thread so it is easy to find among audio/driver threads.
+  fprintf(file,
+          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,"
+          "\"args\":{\"name\":\"main\"}}",
+          (unsigned long)tracer.main_thread);
+  for (int i = 0; i < count; i++) {
+    const TraceEvent* event = &tracer.events[i];
+    // Counters read on different cores may disagree slightly; clamp so no
+    // timestamp goes negative.
+    Uint64 elapsed =
+        event->timestamp > tracer.start ? event->timestamp - tracer.start : 0;
+    fprintf(file,
+            ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,"
+            "\"tid\":%lu}",
+            event->name, event->phase, (double)elapsed * us_per_tick,
+            (unsigned long)event->thread_id);
+  }
+  fprintf(file, "\n]}\n");
+}
+
+// --- Public API Implementations ---
+
+bool tracer_init(const char* path) {
+  tracer.events = SDL_malloc(sizeof(TraceEvent) * TRACE_BUFFER_EVENTS);
+  if (!tracer.events) {
+    fprintf(stderr, "ERROR: Failed to allocate the trace buffer (%d events).\n",
+            TRACE_BUFFER_EVENTS);
+    return false;
+  }
+  SDL_strlcpy(tracer.path, path, sizeof(tracer.path));
+  SDL_AtomicSet(&tracer.next, 0);
+  SDL_AtomicSet(&tracer.dropped, 0);
+  tracer.start = SDL_GetPerformanceCounter();
+  tracer.main_thread = SDL_ThreadID();
+  SDL_AtomicSet(&tracer_enabled, 1);
+  return true;
+}
+
+void tracer_shutdown(void) {
+  if (!tracer.events)
+    return;
+  SDL_AtomicSet(&tracer_enabled, 0);
+
+  int count = SDL_min(SDL_AtomicGet(&tracer.next), TRACE_BUFFER_EVENTS);
+  FILE* file = fopen(tracer.path, "w");
+  if (file) {
+    write_events(file, count);
+    fclose(file);
+    printf("Trace of %d events written to %s.\n", count, tracer.path);
+  } else {
+    fprintf(stderr, "WARN: Failed to write trace to %s.\n", tracer.path);
+  }
+  int dropped = SDL_AtomicGet(&tracer.dropped);
+  if (dropped > 0) {
+    fprintf(stderr,
+            "WARN: Trace buffer was full: dropped %d events (capacity %d).\n",
+            dropped, TRACE_BUFFER_EVENTS);
+  }
+
+  SDL_free(tracer.events);
+  tracer.events = NULL;
+}
+
+void tracer_record(const char* name, char phase) {
+  // Stop claiming slots once the buffer is full so the index cannot wrap.
+  int slot = SDL_AtomicGet(&tracer.next) < TRACE_BUFFER_EVENTS
+                 ? SDL_AtomicAdd(&tracer.next, 1)
+                 : TRACE_BUFFER_EVENTS;
+  if (slot >= TRACE_BUFFER_EVENTS) {
+    SDL_AtomicAdd(&tracer.dropped, 1);
+    return;
+  }
+  TraceEvent* event = &tracer.events[slot];
+  event->name = name;
+  event->timestamp = SDL_GetPerformanceCounter();
+  event->thread_id = SDL_ThreadID();
+  event->phase = phase;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file bot.c
+ * @brief Implements the computer players.
+ *
+ * Bots fill in movement through a keyboard state array on the stack and
+ * tick_input_capture(), so they produce exactly the key bits a human would.
+ */
+
+#include "game/bot.h"
+
+#include <string.h>
+
+#include "utils/constants.h"
+
+/// Command-line names, indexed by BotKind.
+static const char* const BOT_NAMES[BOT_KIND_COUNT] = {"script", "evade"};
+
+// --- Private Helpers ---
+
+/**
+ * @brief Aims a shot at a point if this is a firing tick.
+ * @param tick The index of the current tick.
+ * @param x The X coordinate to aim at.
+ * @param y The Y coordinate to aim at.
+ * @param input A pointer to the TickInput to update.
+ */
+static void aim(Uint64 tick, float x, float y, TickInput* input) {
+  input->fire = tick % BOT_FIRE_PERIOD == 0;
+  input->aim_x = (int)x;
+  input->aim_y = (int)y;
+}
+
+/**
+ * @brief Sweeps the play area in a fixed pattern.
+ *
+ * The player holds each of the eight directions for BOT_MOVE_PERIOD ticks,
+ * so it meets enemies and projectiles from every side, and shoots at the
+ * oldest live enemy, or at the screen center when there is none.
+ * @param world A constant pointer to the world.
+ * @param tick The index of the current tick.
+ * @param input A pointer to the TickInput to fill.
+ */
+static void scripted_tick(const World* world, Uint64 tick, TickInput* input) {
+  static const SDL_Scancode DIRECTIONS[8][2] = {
+      {SDL_SCANCODE_W, SDL_SCANCODE_UNKNOWN},
+      {SDL_SCANCODE_W, SDL_SCANCODE_D},
+      {SDL_SCANCODE_D, SDL_SCANCODE_UNKNOWN},
+      {SDL_SCANCODE_S, SDL_SCANCODE_D},
+      {SDL_SCANCODE_S, SDL_SCANCODE_UNKNOWN},
+      {SDL_SCANCODE_S, SDL_SCANCODE_A},
+      {SDL_SCANCODE_A, SDL_SCANCODE_UNKNOWN},
+      {SDL_SCANCODE_W, SDL_SCANCODE_A},
+  };
+  Uint8 keyboard[SDL_NUM_SCANCODES];
+  memset(keyboard, 0, sizeof(keyboard));
+  const SDL_Scancode* keys = DIRECTIONS[(tick / BOT_MOVE_PERIOD) % 8];
+  keyboard[keys[0]] = 1;
+  keyboard[keys[1]] = 1;
+  tick_input_capture(input, keyboard);
+
+  if (world->enemies.slots.count > 0) {
+    aim(tick, world->enemies.x[0], world->enemies.y[0], input);
+  } else {
+    aim(tick, LOGICAL_WIDTH / 2, LOGICAL_HEIGHT / 2, input);
+  }
+}
+
+/**
+ * @brief Adds the push away from one threat, if it is close enough.
+ *
+ * The push has a magnitude of 1 / distance, so the closest threats dominate.
+ * @param player A constant pointer to the player.
+ * @param x The X coordinate of the threat.
+ * @param y The Y coordinate of the threat.
+ * @param push_x A pointer to the X push to add to.
+ * @param push_y A pointer to the Y push to add to.
+ */
+static void add_threat(const Player* player, float x, float y, float* push_x,
+                       float* push_y) {
+  float dx = player->x - x;
+  float dy = player->y - y;
+  float distance_squared = SDL_max(dx * dx + dy * dy, 1.0f);
+  if (distance_squared > BOT_DANGER_RADIUS * BOT_DANGER_RADIUS)
+    return;
+  *push_x += dx / distance_squared;
+  *push_y += dy / distance_squared;
+}
+
+/**
+ * @brief Dodges nearby threats and shoots at the closest enemy.
+ * @param world A constant pointer to the world.
+ * @param tick The index of the current tick.
+ * @param input A pointer to the TickInput to fill.
+ */
+static void evasive_tick(const World* world, Uint64 tick, TickInput* input) {
+  const Player* player = &world->player;
+  const EnemyPool* enemies = &world->enemies;
+  const ProjectilePool* projectiles = &world->projectiles;
+
+  // A weak pull toward the center keeps the bot from being cornered.
+  float push_x = (LOGICAL_WIDTH / 2 - player->x) * BOT_CENTER_PULL;
+  float push_y = (LOGICAL_HEIGHT / 2 - player->y) * BOT_CENTER_PULL;
+  float target_x = LOGICAL_WIDTH / 2;
+  float target_y = LOGICAL_HEIGHT / 2;
+  float nearest = -1.0f;
+  for (int i = 0; i < enemies->slots.count; i++) {
+    add_threat(player, enemies->x[i], enemies->y[i], &push_x, &push_y);
+    float dx = enemies->x[i] - player->x;
+    float dy = enemies->y[i] - player->y;
+    float distance_squared = dx * dx + dy * dy;
+    if (nearest < 0.0f || distance_squared < nearest) {
+      nearest = distance_squared;
+      target_x = enemies->x[i];
+      target_y = enemies->y[i];
+    }
+  }
+  for (int j = 0; j < projectiles->slots.count; j++) {
+    if (projectiles->is_enemy[j])
+      add_threat(player, projectiles->x[j], projectiles->y[j], &push_x,
+                 &push_y);
+  }
+
+  Uint8 keyboard[SDL_NUM_SCANCODES];
+  memset(keyboard, 0, sizeof(keyboard));
+  keyboard[SDL_SCANCODE_W] = push_y < -BOT_STEER_DEADZONE;
+  keyboard[SDL_SCANCODE_S] = push_y > BOT_STEER_DEADZONE;
+  keyboard[SDL_SCANCODE_A] = push_x < -BOT_STEER_DEADZONE;
+  keyboard[SDL_SCANCODE_D] = push_x > BOT_STEER_DEADZONE;
+  tick_input_capture(input, keyboard);
+  aim(tick, target_x, target_y, input);
+}
+
+// --- Public API Implementations ---
+
+void bot_tick(BotKind kind, const World* world, Uint64 tick,
+              TickInput* input) {
+  if (kind == BOT_EVASIVE) {
+    evasive_tick(world, tick, input);
+  } else {
+    scripted_tick(world, tick, input);
+  }
+}
+
+bool bot_parse_kind(const char* name, BotKind* out) {
+  for (int i = 0; i < BOT_KIND_COUNT; i++) {
+    if (strcmp(name, BOT_NAMES[i]) == 0) {
+      *out = (BotKind)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char* bot_kind_name(BotKind kind) {
+  return BOT_NAMES[kind];
+}
@@ -0,0 +1,198 @@
+/**
+ * @file entity_kernels.c
+ * @brief Implements the SIMD kernels used to integrate and cull entity pools.
+ *
+ * Every kernel has a scalar version, which handles the tail of each range and
+ * non-x86 targets, an SSE2 version processing four entities per instruction,
+ * and an AVX2 version processing eight. The AVX2 functions are compiled with a
+ * per-function target attribute, so the default build still runs on any
+ * x86-64 CPU and only takes the wider path after a runtime CPU check.
+ */
+
+#include "game/entity_kernels.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#define KERNELS_HAVE_SSE2 1
+#if defined(__GNUC__)
+#define KERNELS_HAVE_AVX2 1
+#define KERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// --- Private Helpers ---
+
+#if defined(KERNELS_HAVE_AVX2)
+/**
+ * @brief Reports whether the AVX2 kernels can be used on this CPU.
+ *
+ * The result is cached after the first call. Concurrent first calls are
+ * harmless because every caller computes and stores the same value.
+ * @return True if the CPU supports AVX2, false otherwise.
+ */
+static bool cpu_has_avx2(void) {
+  static int has_avx2 = -1;
+  if (has_avx2 < 0) {
+    has_avx2 = SDL_HasAVX2() ? 1 : 0;
+  }
+  return has_avx2 == 1;
+}
+#endif
+
+/**
+ * @brief Scalar integration, used for range tails and non-SIMD targets.
+ */
+static void integrate_scalar(float* x, float* y, const float* dx,
+                             const float* dy, int begin, int end) {
+  for (int i = begin; i < end; i++) {
+    x[i] += dx[i];
+    y[i] += dy[i];
+  }
+}
+
+/**
+ * @brief Scalar culling, used for range tails and non-SIMD targets.
+ * @return The updated number of culled indices.
+ */
+static int cull_scalar(const float* x, const float* y, int begin, int end,
+                       float min_x, float min_y, float max_x, float max_y,
+                       int* culled, int culled_count) {
+  for (int i = begin; i < end; i++) {
+    if (x[i] < min_x || x[i] > max_x || y[i] < min_y || y[i] > max_y) {
+      culled[culled_count++] = i;
+    }
+  }
+  return culled_count;
+}
+
+#if defined(KERNELS_HAVE_SSE2)
+/**
+ * @brief SSE2 integration of four entities per iteration.
+ * @return The index of the first entity left for the scalar tail.
+ */
+static int integrate_sse2(float* x, float* y, const float* dx,
+                          const float* dy, int count) {
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(dx + i)));
+    _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(dy + i)));
+  }
+  return i;
+}
+
+/**
+ * @brief SSE2 culling of four entities per iteration.
+ * @return The index of the first entity left for the scalar tail.
+ */
+static int cull_sse2(const float* x, const float* y, int count, float min_x,
+                     float min_y, float max_x, float max_y, int* culled,
+                     int* culled_count) {
+  const __m128 lo_x = _mm_set1_ps(min_x);
+  const __m128 lo_y = _mm_set1_ps(min_y);
+  const __m128 hi_x = _mm_set1_ps(max_x);
+  const __m128 hi_y = _mm_set1_ps(max_y);
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 px = _mm_loadu_ps(x + i);
+    __m128 py = _mm_loadu_ps(y + i);
+    __m128 outside =
+        _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(px, lo_x), _mm_cmpgt_ps(px, hi_x)),
+                  _mm_or_ps(_mm_cmplt_ps(py, lo_y), _mm_cmpgt_ps(py, hi_y)));
+    // Almost every lane stays on screen, so only the rare lanes that left it
+    // are visited, lowest first to keep the output sorted.
+    int mask = _mm_movemask_ps(outside);
+    while (mask) {
+      culled[(*culled_count)++] = i + __builtin_ctz((unsigned)mask);
+      mask &= mask - 1;
+    }
+  }
+  return i;
+}
+#endif
+
+#if defined(KERNELS_HAVE_AVX2)
+/**
+ * @brief AVX2 integration of eight entities per iteration.
+ * @return The index of the first entity left for the scalar tail.
+ */
+KERNELS_TARGET_AVX2 static int integrate_avx2(float* x, float* y,
+                                              const float* dx,
+                                              const float* dy, int count) {
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(
+        x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(dx + i)));
+    _mm256_storeu_ps(
+        y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(dy + i)));
+  }
+  return i;
+}
+
+/**
+ * @brief AVX2 culling of eight entities per iteration.
+ * @return The index of the first entity left for the scalar tail.
+ */
+KERNELS_TARGET_AVX2 static int cull_avx2(const float* x, const float* y,
+                                         int count, float min_x, float min_y,
+                                         float max_x, float max_y,
+                                         int* culled, int* culled_count) {
+  const __m256 lo_x = _mm256_set1_ps(min_x);
+  const __m256 lo_y = _mm256_set1_ps(min_y);
+  const __m256 hi_x = _mm256_set1_ps(max_x);
+  const __m256 hi_y = _mm256_set1_ps(max_y);
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 px = _mm256_loadu_ps(x + i);
+    __m256 py = _mm256_loadu_ps(y + i);
+    __m256 outside = _mm256_or_ps(
+        _mm256_or_ps(_mm256_cmp_ps(px, lo_x, _CMP_LT_OQ),
+                     _mm256_cmp_ps(px, hi_x, _CMP_GT_OQ)),
+        _mm256_or_ps(_mm256_cmp_ps(py, lo_y, _CMP_LT_OQ),
+                     _mm256_cmp_ps(py, hi_y, _CMP_GT_OQ)));
+    int mask = _mm256_movemask_ps(outside);
+    while (mask) {
+      culled[(*culled_count)++] = i + __builtin_ctz((unsigned)mask);
+      mask &= mask - 1;
+    }
+  }
+  return i;
+}
+#endif
+
+// --- Public API Implementations ---
+
+void entity_kernels_integrate(float* x, float* y, const float* dx,
+                              const float* dy, int count) {
+  int done = 0;
+#if defined(KERNELS_HAVE_AVX2)
+  if (cpu_has_avx2()) {
+    done = integrate_avx2(x, y, dx, dy, count);
+  } else {
+    done = integrate_sse2(x, y, dx, dy, count);
+  }
+#elif defined(KERNELS_HAVE_SSE2)
+  done = integrate_sse2(x, y, dx, dy, count);
+#endif
+  integrate_scalar(x, y, dx, dy, done, count);
+}
+
+int entity_kernels_cull(const float* x, const float* y, int count,
+                        float min_x, float min_y, float max_x, float max_y,
+                        int* culled) {
+  int done = 0;
+  int culled_count = 0;
+#if defined(KERNELS_HAVE_AVX2)
+  if (cpu_has_avx2()) {
+    done = cull_avx2(x, y, count, min_x, min_y, max_x, max_y, culled,
+                     &culled_count);
+  } else {
+    done = cull_sse2(x, y, count, min_x, min_y, max_x, max_y, culled,
+                     &culled_count);
+  }
+#elif defined(KERNELS_HAVE_SSE2)
+  done = cull_sse2(x, y, count, min_x, min_y, max_x, max_y, culled,
+                   &culled_count);
+#endif
+  return cull_scalar(x, y, done, count, min_x, min_y, max_x, max_y, culled,
+                     culled_count);
+}
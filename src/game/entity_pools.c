@@ -0,0 +1,213 @@
+/**
+ * @file entity_pools.c
+ * @brief Implements O(1) allocation and handle lookup for the entity pools.
+ *
+ * The slot bookkeeping is shared by all pools. Each pool wrapper only adds
+ * the steps that lay out and move its own structure-of-arrays fields.
+ */
+
+#include "game/entity_pools.h"
+
+// --- Private Helpers ---
+
+/**
+ * @brief Allocates one pool array from an arena.
+ * @param arena The arena to allocate from.
+ * @param element_size The size of one element in bytes.
+ * @param capacity The number of elements.
+ * @return A pointer to the array, or NULL if the arena is measuring.
+ */
+static void* alloc_array(Arena* arena, size_t element_size, int capacity) {
+  return arena_alloc(arena, element_size * (size_t)capacity,
+                     ARENA_DEFAULT_ALIGNMENT);
+}
+
+/**
+ * @brief Sets up the bookkeeping for an empty pool.
+ * @param slots A pointer to the EntitySlots to initialize.
+ * @param arena The arena providing the bookkeeping arrays.
+ * @param capacity The maximum number of live entities.
+ */
+static void slots_init(EntitySlots* slots, Arena* arena, int capacity) {
+  *slots = (EntitySlots){0};
+  slots->slot_of = alloc_array(arena, sizeof(Uint32), capacity);
+  slots->index_of = alloc_array(arena, sizeof(Uint32), capacity);
+  slots->generation = alloc_array(arena, sizeof(Uint32), capacity);
+  slots->free_slots = alloc_array(arena, sizeof(Uint32), capacity);
+  slots->capacity = capacity;
+  // Fresh slots are handed out in order, so only the generations need a
+  // defined starting value.
+  if (slots->generation)
+    SDL_memset(slots->generation, 0, sizeof(Uint32) * (size_t)capacity);
+}
+
+/**
+ * @brief Releases every live entity in O(live) time.
+ *
+ * Bumping the generation of each live slot invalidates their handles. All
+ * slots can then be handed out again from the start, because any slot that
+ * was released earlier already had its generation bumped at that time.
+ * @param slots A pointer to the pool's EntitySlots.
+ */
+static void slots_clear(EntitySlots* slots) {
+  for (int i = 0; i < slots->count; i++) {
+    slots->generation[slots->slot_of[i]]++;
+  }
+  slots->count = 0;
+  slots->free_count = 0;
+  slots->slots_used = 0;
+}
+
+/**
+ * @brief Assigns a slot to a new entity appended to the live range.
+ * @param slots A pointer to the pool's EntitySlots.
+ * @return The dense index of the new entity, or -1 if the pool is full.
+ */
+static int slots_acquire(EntitySlots* slots) {
+  if (slots->count >= slots->capacity) {
+    slots->dropped++;
+    return -1;
+  }
+
+  // Prefer recycling a released slot; otherwise hand out a fresh one.
+  Uint32 slot = slots->free_count > 0 ? slots->free_slots[--slots->free_count]
+                                      : (Uint32)slots->slots_used++;
+  int index = slots->count++;
+  slots->slot_of[index] = slot;
+  slots->index_of[slot] = (Uint32)index;
+  return index;
+}
+
+/**
+ * @brief Frees an entity's slot and patches the mapping of the last live
+ * entity, which the caller moves into the hole.
+ * @param slots A pointer to the pool's EntitySlots.
+ * @param index The dense index of the entity being removed.
+ * @return The dense index of the entity to move into `index`, or `index`
+ * itself if it was the last live entity and nothing needs to move.
+ */
+static int slots_release(EntitySlots* slots, int index) {
+  Uint32 slot = slots->slot_of[index];
+  // Bumping the generation invalidates every outstanding handle to the slot.
+  slots->generation[slot]++;
+  slots->free_slots[slots->free_count++] = slot;
+
+  int last = --slots->count;
+  if (index != last) {
+    Uint32 moved = slots->slot_of[last];
+    slots->slot_of[index] = moved;
+    slots->index_of[moved] = (Uint32)index;
+  }
+  return last;
+}
+
+/**
+ * @brief Builds a handle for a live entity.
+ * @param slots A constant pointer to the pool's EntitySlots.
+ * @param index The dense index of the entity.
+ * @return The handle.
+ */
+static EntityHandle slots_handle(const EntitySlots* slots, int index) {
+  Uint32 slot = slots->slot_of[index];
+  return (EntityHandle){slot, slots->generation[slot]};
+}
+
+/**
+ * @brief Resolves a handle back to a dense index.
+ * @param slots A constant pointer to the pool's EntitySlots.
+ * @param handle The handle to resolve.
+ * @return The dense index, or -1 if the handle is stale.
+ */
+static int slots_resolve(const EntitySlots* slots, EntityHandle handle) {
+  if (handle.slot >= (Uint32)slots->slots_used ||
+      slots->generation[handle.slot] != handle.generation)
+    return -1;
+  return (int)slots->index_of[handle.slot];
+}
+
+// --- Projectile Pool ---
+
+void projectile_pool_init(ProjectilePool* pool, Arena* arena, int capacity) {
+  // Hot arrays are laid out first and back to back, followed by cold data.
+  pool->x = alloc_array(arena, sizeof(float), capacity);
+  pool->y = alloc_array(arena, sizeof(float), capacity);
+  pool->dx = alloc_array(arena, sizeof(float), capacity);
+  pool->dy = alloc_array(arena, sizeof(float), capacity);
+  pool->is_enemy = alloc_array(arena, sizeof(bool), capacity);
+  pool->radius = PROJECTILE_RADIUS;
+  pool->prev_x = alloc_array(arena, sizeof(float), capacity);
+  pool->prev_y = alloc_array(arena, sizeof(float), capacity);
+  pool->color = alloc_array(arena, sizeof(SDL_Color), capacity);
+  slots_init(&pool->slots, arena, capacity);
+}
+
+void projectile_pool_clear(ProjectilePool* pool) {
+  slots_clear(&pool->slots);
+}
+
+int projectile_pool_acquire(ProjectilePool* pool) {
+  return slots_acquire(&pool->slots);
+}
+
+void projectile_pool_release(ProjectilePool* pool, int index) {
+  int last = slots_release(&pool->slots, index);
+  if (last == index)
+    return;
+  pool->x[index] = pool->x[last];
+  pool->y[index] = pool->y[last];
+  pool->dx[index] = pool->dx[last];
+  pool->dy[index] = pool->dy[last];
+  pool->is_enemy[index] = pool->is_enemy[last];
+  pool->prev_x[index] = pool->prev_x[last];
+  pool->prev_y[index] = pool->prev_y[last];
+  pool->color[index] = pool->color[last];
+}
+
+EntityHandle projectile_pool_handle(const ProjectilePool* pool, int index) {
+  return slots_handle(&pool->slots, index);
+}
+
+int projectile_pool_resolve(const ProjectilePool* pool, EntityHandle handle) {
+  return slots_resolve(&pool->slots, handle);
+}
+
+// --- Enemy Pool ---
+
+void enemy_pool_init(EnemyPool* pool, Arena* arena, int capacity) {
+  pool->x = alloc_array(arena, sizeof(float), capacity);
+  pool->y = alloc_array(arena, sizeof(float), capacity);
+  pool->dx = alloc_array(arena, sizeof(float), capacity);
+  pool->dy = alloc_array(arena, sizeof(float), capacity);
+  pool->radius = ENEMY_RADIUS;
+  pool->prev_x = alloc_array(arena, sizeof(float), capacity);
+  pool->prev_y = alloc_array(arena, sizeof(float), capacity);
+  slots_init(&pool->slots, arena, capacity);
+}
+
+void enemy_pool_clear(EnemyPool* pool) {
+  slots_clear(&pool->slots);
+}
+
+int enemy_pool_acquire(EnemyPool* pool) {
+  return slots_acquire(&pool->slots);
+}
+
+void enemy_pool_release(EnemyPool* pool, int index) {
+  int last = slots_release(&pool->slots, index);
+  if (last == index)
+    return;
+  pool->x[index] = pool->x[last];
+  pool->y[index] = pool->y[last];
+  pool->dx[index] = pool->dx[last];
+  pool->dy[index] = pool->dy[last];
+  pool->prev_x[index] = pool->prev_x[last];
+  pool->prev_y[index] = pool->prev_y[last];
+}
+
+EntityHandle enemy_pool_handle(const EnemyPool* pool, int index) {
+  return slots_handle(&pool->slots, index);
+}
+
+int enemy_pool_resolve(const EnemyPool* pool, EntityHandle handle) {
+  return slots_resolve(&pool->slots, handle);
+}
@@ -0,0 +1,41 @@
+/**
+ * @file game_events.c
+ * @brief Implements the gameplay event buffer.
+ */
+
+#include "game/game_events.h"
+
+// --- Public API Implementations ---
+
+void game_events_init(GameEventBuffer* buffer, Arena* arena, int capacity) {
+  buffer->events = arena_alloc(arena, sizeof(GameEvent) * (size_t)capacity,
+                               ARENA_DEFAULT_ALIGNMENT);
+  buffer->capacity = capacity;
+  buffer->count = 0;
+  buffer->dropped = 0;
+}
+
+void game_events_clear(GameEventBuffer* buffer) {
+  buffer->count = 0;
+}
+
+void game_events_push(GameEventBuffer* buffer, GameEventType type, float x,
+                      float y) {
+  if (buffer->count >= buffer->capacity) {
+    buffer->dropped++;
+    return;
+  }
+  GameEvent* event = &buffer->events[buffer->count++];
+  event->type = type;
+  event->x = x;
+  event->y = y;
+}
+
+int game_events_count(const GameEventBuffer* buffer, GameEventType type) {
+  int count = 0;
+  for (int i = 0; i < buffer->count; i++) {
+    if (buffer->events[i].type == type)
+      count++;
+  }
+  return count;
+}
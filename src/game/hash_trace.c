@@ -0,0 +1,155 @@
+/**
+ * @file hash_trace.c
+ * @brief Implements the per-tick hash file.
+ *
+ * The file is the header "SFHT", a version byte and the world seed, followed
+ * by one 64-bit hash per tick; all integers are little-endian.
+ */
+
+#include "game/hash_trace.h"
+
+#include <string.h>
+
+#define HASH_TRACE_MAGIC "SFHT"  // First bytes of every hash file.
+#define HASH_TRACE_VERSION 1     // Bumped whenever the format changes.
+
+// --- Private Helpers ---
+
+/**
+ * @brief Writes a 64-bit value as little-endian bytes.
+ * @param file The file to write to.
+ * @param value The value to write.
+ */
+static void write_u64(FILE* file, Uint64 value) {
+  Uint8 bytes[8];
+  for (int i = 0; i < 8; i++) {
+    bytes[i] = (Uint8)(value >> (8 * i));
+  }
+  fwrite(bytes, 1, sizeof(bytes), file);
+}
+
+/**
+ * @brief Reads a little-endian 64-bit value.
+ * @param file The file to read from.
+ * @param out A pointer that receives the value.
+ * @return true on success, false at the end of the file.
+ */
+static bool read_u64(FILE* file, Uint64* out) {
+  Uint8 bytes[8];
+  if (fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes))
+    return false;
+  Uint64 value = 0;
+  for (int i = 0; i < 8; i++) {
+    value |= (Uint64)bytes[i] << (8 * i);
+  }
+  *out = value;
+  return true;
+}
+
+// --- Public API Implementations ---
+
+bool hash_trace_create(HashTrace* trace, const char* path, Uint64 seed) {
+  memset(trace, 0, sizeof(*trace));
+  trace->file = fopen(path, "wb");
+  if (!trace->file) {
+    fprintf(stderr, "ERROR: Failed to create hash file %s.\n", path);
+    return false;
+  }
+  trace->writing = true;
+  fwrite(HASH_TRACE_MAGIC, 1, 4, trace->file);
+  fputc(HASH_TRACE_VERSION, trace->file);
+  write_u64(trace->file, seed);
+  return true;
+}
+
+bool hash_trace_open(HashTrace* trace, const char* path, Uint64 seed) {
+  memset(trace, 0, sizeof(*trace));
+  trace->file = fopen(path, "rb");
+  if (!trace->file) {
+    fprintf(stderr, "ERROR: Failed to open hash file %s.\n", path);
+    return false;
+  }
+
+  char magic[4];
+  Uint64 reference_seed;
+  if (fread(magic, 1, 4, trace->file) != 4 ||
+      memcmp(magic, HASH_TRACE_MAGIC, 4) != 0 ||
+      fgetc(trace->file) != HASH_TRACE_VERSION ||
+      !read_u64(trace->file, &reference_seed)) {
+    fprintf(stderr, "ERROR: %s is not a valid hash file.\n", path);
+    fclose(trace->file);
+    trace->file = NULL;
+    return false;
+  }
+  if (reference_seed != seed) {
+    fprintf(stderr,
+            "ERROR: %s was recorded with seed %llu, but this run uses seed "
+            "%llu.\n",
+            path, (unsigned long long)reference_seed,
+            (unsigned long long)seed);
+    fclose(trace->file);
+    trace->file = NULL;
+    return false;
+  }
+  return true;
+}
+
+void hash_trace_write(HashTrace* trace, Uint64 hash) {
+  write_u64(trace->file, hash);
+  trace->ticks++;
+}
+
+bool hash_trace_verify(HashTrace* trace, Uint64 hash, Uint64 world_tick) {
+  if (trace->diverged)
+    return false;
+  trace->ticks++;
+
+  Uint64 expected;
+  if (!read_u64(trace->file, &expected)) {
+    fprintf(stderr,
+            "ERROR: The run outlasted the reference, which ends after %llu "
+            "ticks.\n",
+            (unsigned long long)(trace->ticks - 1));
+    trace->diverged = true;
+    return false;
+  }
+  if (hash != expected) {
+    fprintf(stderr,
+            "ERROR: State diverged from the reference at tick %llu of the run "
+            "(world tick %llu).\n",
+            (unsigned long long)trace->ticks, (unsigned long long)world_tick);
+    trace->diverged = true;
+    return false;
+  }
+  return true;
+}
+
+bool hash_trace_close(HashTrace* trace) {
+  if (!trace->file)
+    return true;
+
+  bool ok = true;
+  if (trace->writing) {
+    if (ferror(trace->file)) {
+      fprintf(stderr, "WARN: Failed to write the whole hash file.\n");
+      ok = false;
+    }
+  } else if (!trace->diverged) {
+    Uint64 unused;
+    if (read_u64(trace->file, &unused)) {
+      fprintf(stderr,
+              "ERROR: The run ended after %llu ticks, before the reference "
+              "did.\n",
+              (unsigned long long)trace->ticks);
+      ok = false;
+    } else {
+      printf("State matched the reference on all %llu ticks.\n",
+             (unsigned long long)trace->ticks);
+    }
+  } else {
+    ok = false;
+  }
+  fclose(trace->file);
+  trace->file = NULL;
+  return ok;
+}
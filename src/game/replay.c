@@ -0,0 +1,299 @@
+/**
+ * @file replay.c
+ * @brief Implements the replay file format.
+ *
+ * A replay starts with a fixed header (all integers little-endian):
+ *
+ *     "SFRP"  version:u8  seed:u64  tick_rate:u32  max_projectiles:u32
+ *     max_enemies:u32  enemy_spawn_rate:f32  ai_event_budget:u32
+ *
+ * where the spawn rate is stored as the bits of its IEEE 754 single.
+ * followed by one record per tick or run of ticks. The first byte of a
+ * record either has its top bit set, meaning "repeat the previous keys for
+ * (byte & 0x7F) + 1 ticks without firing", or is a mask of what changed:
+ * REPLAY_KEYS_CHANGED is followed by the new key byte, REPLAY_AIM_CHANGED by
+ * the X and Y deltas of the aim as zigzag varints, and REPLAY_FIRE marks a
+ * shot. The aim is only stored with shots, since it has no other effect.
+ */
+
+#include "game/replay.h"
+
+#include <string.h>
+
+#include "utils/constants.h"
+
+#define REPLAY_MAGIC "SFRP"       // First bytes of every replay file.
+#define REPLAY_VERSION 2          // Bumped whenever the format changes.
+#define REPLAY_RUN_FLAG 0x80      // Record byte is a run of unchanged ticks.
+#define REPLAY_MAX_RUN 128        // Longest run a single byte can encode.
+#define REPLAY_KEYS_CHANGED 0x01  // A new key byte follows.
+#define REPLAY_AIM_CHANGED 0x02   // Aim deltas follow.
+#define REPLAY_FIRE 0x04          // The player fires this tick.
+
+/// The keys world_update() reads, in the order of their TickInput bits.
+static const SDL_Scancode TICK_KEYS[8] = {
+    SDL_SCANCODE_W,  SDL_SCANCODE_A,    SDL_SCANCODE_S,    SDL_SCANCODE_D,
+    SDL_SCANCODE_UP, SDL_SCANCODE_LEFT, SDL_SCANCODE_DOWN, SDL_SCANCODE_RIGHT,
+};
+
+// --- Private Helpers ---
+
+/**
+ * @brief Writes an unsigned integer as little-endian bytes.
+ * @param file The file to write to.
+ * @param value The value to write.
+ * @param size The number of bytes to write.
+ */
+static void write_le(FILE* file, Uint64 value, int size) {
+  for (int i = 0; i < size; i++) {
+    fputc((int)((value >> (8 * i)) & 0xFF), file);
+  }
+}
+
+/**
+ * @brief Reads an unsigned little-endian integer.
+ * @param file The file to read from.
+ * @param size The number of bytes to read.
+ * @param out A pointer that receives the value.
+ * @return true on success, false at the end of the file.
+ */
+static bool read_le(FILE* file, int size, Uint64* out) {
+  Uint64 value = 0;
+  for (int i = 0; i < size; i++) {
+    int c = fgetc(file);
+    if (c == EOF)
+      return false;
+    value |= (Uint64)c << (8 * i);
+  }
+  *out = value;
+  return true;
+}
+
+/**
+ * @brief Writes a signed value as a zigzag-encoded varint, so small deltas of
+ * either sign take a single byte.
+ * @param file The file to write to.
+ * @param value The value to write.
+ */
+static void write_varint(FILE* file, int value) {
+  Uint32 zigzag = ((Uint32)value << 1) ^ (Uint32)(value >> 31);
+  while (zigzag >= 0x80) {
+    fputc((int)(zigzag & 0x7F) | 0x80, file);
+    zigzag >>= 7;
+  }
+  fputc((int)zigzag, file);
+}
+
+/**
+ * @brief Reads a value written by write_varint().
+ * @param file The file to read from.
+ * @param out A pointer that receives the value.
+ * @return true on success, false if the file ends or the varint is invalid.
+ */
+static bool read_varint(FILE* file, int* out) {
+  Uint32 zigzag = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    int c = fgetc(file);
+    if (c == EOF)
+      return false;
+    zigzag |= (Uint32)(c & 0x7F) << shift;
+    if (!(c & 0x80)) {
+      *out = (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Writes the pending run of unchanged ticks, if any.
+ * @param replay A pointer to the Replay being recorded.
+ */
+static void flush_run(Replay* replay) {
+  if (replay->run > 0) {
+    fputc(REPLAY_RUN_FLAG | (replay->run - 1), replay->file);
+    replay->run = 0;
+  }
+}
+
+/**
+ * @brief Returns the previous tick again, without a shot.
+ * @param replay A pointer to the Replay being played back.
+ * @param tick A pointer that receives the tick's input.
+ */
+static void repeat_previous(Replay* replay, TickInput* tick) {
+  *tick = replay->previous;
+  tick->fire = false;
+  replay->ticks++;
+}
+
+// --- Public API Implementations ---
+
+void tick_input_capture(TickInput* tick, const Uint8* keyboard) {
+  tick->keys = 0;
+  for (int i = 0; i < 8; i++) {
+    if (keyboard[TICK_KEYS[i]])
+      tick->keys |= (Uint8)(1 << i);
+  }
+}
+
+void tick_input_apply(const TickInput* tick, Uint8* keyboard) {
+  for (int i = 0; i < 8; i++) {
+    keyboard[TICK_KEYS[i]] = (tick->keys >> i) & 1;
+  }
+}
+
+bool replay_create(Replay* replay, const char* path,
+                   const WorldConfig* config) {
+  memset(replay, 0, sizeof(*replay));
+  replay->file = fopen(path, "wb");
+  if (!replay->file) {
+    fprintf(stderr, "ERROR: Failed to create replay file %s.\n", path);
+    return false;
+  }
+  replay->writing = true;
+
+  fwrite(REPLAY_MAGIC, 1, 4, replay->file);
+  fputc(REPLAY_VERSION, replay->file);
+  write_le(replay->file, config->seed, 8);
+  write_le(replay->file, (Uint64)config->tick_rate, 4);
+  write_le(replay->file, (Uint64)config->max_projectiles, 4);
+  write_le(replay->file, (Uint64)config->max_enemies, 4);
+  Uint32 spawn_rate_bits;
+  memcpy(&spawn_rate_bits, &config->enemy_spawn_rate, sizeof(Uint32));
+  write_le(replay->file, spawn_rate_bits, 4);
+  write_le(replay->file, (Uint64)config->ai_event_budget, 4);
+  return true;
+}
+
+bool replay_open(Replay* replay, const char* path, WorldConfig* config) {
+  memset(replay, 0, sizeof(*replay));
+  replay->file = fopen(path, "rb");
+  if (!replay->file) {
+    fprintf(stderr, "ERROR: Failed to open replay file %s.\n", path);
+    return false;
+  }
+
+  char magic[4];
+  Uint64 seed, tick_rate, max_projectiles, max_enemies, spawn_rate_bits,
+      ai_event_budget;
+  bool ok = fread(magic, 1, 4, replay->file) == 4 &&
+            memcmp(magic, REPLAY_MAGIC, 4) == 0 &&
+            fgetc(replay->file) == REPLAY_VERSION &&
+            read_le(replay->file, 8, &seed) &&
+            read_le(replay->file, 4, &tick_rate) &&
+            read_le(replay->file, 4, &max_projectiles) &&
+            read_le(replay->file, 4, &max_enemies) &&
+            read_le(replay->file, 4, &spawn_rate_bits) &&
+            read_le(replay->file, 4, &ai_event_budget) &&
+            tick_rate >= MIN_SIM_RATE && tick_rate <= MAX_SIM_RATE &&
+            max_projectiles >= 1 && max_projectiles <= MAX_POOL_CAPACITY &&
+            max_enemies >= 1 && max_enemies <= MAX_POOL_CAPACITY &&
+            ai_event_budget <= MAX_POOL_CAPACITY;
+  float spawn_rate = 0.0f;
+  if (ok) {
+    Uint32 bits = (Uint32)spawn_rate_bits;
+    memcpy(&spawn_rate, &bits, sizeof(float));
+    // The negated test also rejects NaN.
+    ok = spawn_rate >= 0.0f && spawn_rate <= MAX_ENEMY_SPAWN_RATE;
+  }
+  if (!ok) {
+    fprintf(stderr, "ERROR: %s is not a valid replay file.\n", path);
+    replay_close(replay);
+    return false;
+  }
+
+  config->seed = seed;
+  config->tick_rate = (int)tick_rate;
+  config->max_projectiles = (int)max_projectiles;
+  config->max_enemies = (int)max_enemies;
+  config->enemy_spawn_rate = spawn_rate;
+  config->ai_event_budget = (int)ai_event_budget;
+  return true;
+}
+
+void replay_write_tick(Replay* replay, const TickInput* tick) {
+  TickInput* previous = &replay->previous;
+  replay->ticks++;
+  bool keys_changed = tick->keys != previous->keys;
+  if (!keys_changed && !tick->fire) {
+    if (++replay->run == REPLAY_MAX_RUN)
+      flush_run(replay);
+    return;
+  }
+
+  flush_run(replay);
+  bool aim_changed = tick->fire && (tick->aim_x != previous->aim_x ||
+                                    tick->aim_y != previous->aim_y);
+  Uint8 mask = (keys_changed ? REPLAY_KEYS_CHANGED : 0) |
+               (aim_changed ? REPLAY_AIM_CHANGED : 0) |
+               (tick->fire ? REPLAY_FIRE : 0);
+  fputc(mask, replay->file);
+  if (keys_changed)
+    fputc(tick->keys, replay->file);
+  if (aim_changed) {
+    write_varint(replay->file, tick->aim_x - previous->aim_x);
+    write_varint(replay->file, tick->aim_y - previous->aim_y);
+  }
+
+  previous->keys = tick->keys;
+  if (tick->fire) {
+    previous->aim_x = tick->aim_x;
+    previous->aim_y = tick->aim_y;
+  }
+}
+
+bool replay_read_tick(Replay* replay, TickInput* tick) {
+  if (replay->run > 0) {
+    replay->run--;
+    repeat_previous(replay, tick);
+    return true;
+  }
+
+  int mask = fgetc(replay->file);
+  if (mask == EOF)
+    return false;
+  if (mask & REPLAY_RUN_FLAG) {
+    replay->run = mask & ~REPLAY_RUN_FLAG;
+    repeat_previous(replay, tick);
+    return true;
+  }
+
+  TickInput* previous = &replay->previous;
+  int key_byte = 0;
+  int dx = 0, dy = 0;
+  bool ok = !(mask & ~(REPLAY_KEYS_CHANGED | REPLAY_AIM_CHANGED | REPLAY_FIRE));
+  if (ok && (mask & REPLAY_KEYS_CHANGED)) {
+    key_byte = fgetc(replay->file);
+    ok = key_byte != EOF;
+  }
+  if (ok && (mask & REPLAY_AIM_CHANGED)) {
+    ok = read_varint(replay->file, &dx) && read_varint(replay->file, &dy);
+  }
+  if (!ok) {
+    fprintf(stderr, "WARN: Replay is damaged after tick %llu; stopping.\n",
+            (unsigned long long)replay->ticks);
+    return false;
+  }
+
+  if (mask & REPLAY_KEYS_CHANGED)
+    previous->keys = (Uint8)key_byte;
+  previous->aim_x += dx;
+  previous->aim_y += dy;
+  *tick = *previous;
+  tick->fire = (mask & REPLAY_FIRE) != 0;
+  replay->ticks++;
+  return true;
+}
+
+void replay_close(Replay* replay) {
+  if (!replay->file)
+    return;
+  if (replay->writing) {
+    flush_run(replay);
+    if (ferror(replay->file))
+      fprintf(stderr, "WARN: Failed to write the whole replay.\n");
+  }
+  fclose(replay->file);
+  replay->file = NULL;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file spatial_grid.c
+ * @brief Implements the uniform-grid spatial hash used by the collision
+ * broadphase.
+ *
+ * The grid is rebuilt every tick with a two-pass counting sort: items are
+ * appended together with their cell, then scattered into contiguous per-cell
+ * buckets. This keeps the rebuild O(items + cells) with no allocations.
+ */
+
+#include "game/spatial_grid.h"
+
+#include <string.h>
+
+// --- Private Helpers ---
+
+/**
+ * @brief Converts a logical coordinate to a cell coordinate, clamping values
+ * outside the play area to the nearest border cell.
+ * @param value The logical coordinate.
+ * @param cell_count The number of cells along this axis.
+ * @return The clamped cell coordinate.
+ */
+static int coord_to_cell(float value, int cell_count) {
+  int cell = (int)(value / COLLISION_GRID_CELL_SIZE);
+  if (cell < 0)
+    return 0;
+  if (cell >= cell_count)
+    return cell_count - 1;
+  return cell;
+}
+
+// --- Public API Implementations ---
+
+void spatial_grid_init(SpatialGrid* grid, Arena* arena, int capacity) {
+  size_t bytes = sizeof(int) * (size_t)capacity;
+  grid->items = arena_alloc(arena, bytes, ARENA_DEFAULT_ALIGNMENT);
+  grid->pending_index = arena_alloc(arena, bytes, ARENA_DEFAULT_ALIGNMENT);
+  grid->pending_cell = arena_alloc(arena, bytes, ARENA_DEFAULT_ALIGNMENT);
+  grid->count = 0;
+  grid->capacity = capacity;
+}
+
+void spatial_grid_clear(SpatialGrid* grid) {
+  grid->count = 0;
+}
+
+void spatial_grid_insert(SpatialGrid* grid, int index, float x, float y) {
+  if (grid->count >= grid->capacity)
+    return;
+  int col = coord_to_cell(x, SPATIAL_GRID_COLS);
+  int row = coord_to_cell(y, SPATIAL_GRID_ROWS);
+  grid->pending_index[grid->count] = index;
+  grid->pending_cell[grid->count] = row * SPATIAL_GRID_COLS + col;
+  grid->count++;
+}
+
+void spatial_grid_finalize(SpatialGrid* grid) {
+  // Pass 1: count the items in each cell, offset by one so the prefix sum
+  // below turns the counts directly into start offsets.
+  memset(grid->cell_start, 0, sizeof(grid->cell_start));
+  for (int i = 0; i < grid->count; i++) {
+    grid->cell_start[grid->pending_cell[i] + 1]++;
+  }
+  for (int c = 0; c < SPATIAL_GRID_CELLS; c++) {
+    grid->cell_start[c + 1] += grid->cell_start[c];
+  }
+
+  // Pass 2: scatter the items into their buckets. Walking the pending list in
+  // order keeps the sort stable, so each bucket preserves insertion order.
+  int cursor[SPATIAL_GRID_CELLS];
+  memcpy(cursor, grid->cell_start, sizeof(cursor));
+  for (int i = 0; i < grid->count; i++) {
+    grid->items[cursor[grid->pending_cell[i]]++] = grid->pending_index[i];
+  }
+}
+
+SpatialGridRange spatial_grid_query(float x, float y, float radius) {
+  SpatialGridRange range;
+  range.col_min = coord_to_cell(x - radius, SPATIAL_GRID_COLS);
+  range.col_max = coord_to_cell(x + radius, SPATIAL_GRID_COLS);
+  range.row_min = coord_to_cell(y - radius, SPATIAL_GRID_ROWS);
+  range.row_max = coord_to_cell(y + radius, SPATIAL_GRID_ROWS);
+  return range;
+}
+
+const int* spatial_grid_cell_items(const SpatialGrid* grid, int col, int row,
+                                   int* count) {
+  int cell = row * SPATIAL_GRID_COLS + col;
+  *count = grid->cell_start[cell + 1] - grid->cell_start[cell];
+  return &grid->items[grid->cell_start[cell]];
+}
@@ -0,0 +1,158 @@
+/**
+ * @file timer_wheel.c
+ * @brief Implements the timer wheel.
+ *
+ * Lists are doubly linked so a rescheduled timer can leave its bucket in
+ * O(1). The backlog is stored as one more list after the buckets.
+ */
+
+#include "game/timer_wheel.h"
+
+#include <string.h>
+
+#define TIMER_IDLE -1  // List index of a timer that is not scheduled.
+
+// --- Private Helpers ---
+
+/**
+ * @brief Allocates one wheel array from an arena.
+ * @param arena The arena to allocate from.
+ * @param element_size The size of one element in bytes.
+ * @param count The number of elements.
+ * @return A pointer to the array, or NULL if the arena is measuring.
+ */
+static void* alloc_array(Arena* arena, size_t element_size, int count) {
+  return arena_alloc(arena, element_size * (size_t)count,
+                     ARENA_DEFAULT_ALIGNMENT);
+}
+
+/**
+ * @brief Returns the index of the backlog list.
+ * @param wheel A constant pointer to the TimerWheel.
+ * @return The list index after the last bucket.
+ */
+static int backlog(const TimerWheel* wheel) {
+  return wheel->bucket_count;
+}
+
+/**
+ * @brief Appends an idle timer to the end of a list.
+ * @param wheel A pointer to the TimerWheel.
+ * @param list The index of the list.
+ * @param timer The index of the timer.
+ */
+static void link_timer(TimerWheel* wheel, int list, int timer) {
+  int tail = wheel->tails[list];
+  wheel->prev[timer] = tail;
+  wheel->next[timer] = -1;
+  if (tail >= 0) {
+    wheel->next[tail] = timer;
+  } else {
+    wheel->heads[list] = timer;
+  }
+  wheel->tails[list] = timer;
+  wheel->list[timer] = list;
+}
+
+/**
+ * @brief Removes a timer from the list it is filed in.
+ * @param wheel A pointer to the TimerWheel.
+ * @param timer The index of a scheduled timer.
+ */
+static void unlink_timer(TimerWheel* wheel, int timer) {
+  int list = wheel->list[timer];
+  int prev = wheel->prev[timer];
+  int next = wheel->next[timer];
+  if (prev >= 0) {
+    wheel->next[prev] = next;
+  } else {
+    wheel->heads[list] = next;
+  }
+  if (next >= 0) {
+    wheel->prev[next] = prev;
+  } else {
+    wheel->tails[list] = prev;
+  }
+  wheel->list[timer] = TIMER_IDLE;
+}
+
+// --- Public API Implementations ---
+
+void timer_wheel_init(TimerWheel* wheel, Arena* arena, int capacity,
+                      int max_delay) {
+  // A due tick may be up to max_delay ticks ahead, so that many buckets plus
+  // the current one are needed for it not to wrap onto an earlier tick.
+  int buckets = 1;
+  while (buckets <= max_delay) {
+    buckets *= 2;
+  }
+  wheel->bucket_count = buckets;
+  wheel->capacity = capacity;
+
+  int lists = buckets + 1;
+  wheel->next = alloc_array(arena, sizeof(int), capacity);
+  wheel->prev = alloc_array(arena, sizeof(int), capacity);
+  wheel->list = alloc_array(arena, sizeof(int), capacity);
+  wheel->due_tick = alloc_array(arena, sizeof(Uint64), capacity);
+  wheel->tag = alloc_array(arena, sizeof(Uint32), capacity);
+  wheel->heads = alloc_array(arena, sizeof(int), lists);
+  wheel->tails = alloc_array(arena, sizeof(int), lists);
+  // All-ones bytes read as -1: every timer idle and every list empty.
+  if (wheel->list) {
+    memset(wheel->list, 0xFF, sizeof(int) * (size_t)capacity);
+    memset(wheel->heads, 0xFF, sizeof(int) * (size_t)lists);
+    memset(wheel->tails, 0xFF, sizeof(int) * (size_t)lists);
+  }
+}
+
+void timer_wheel_clear(TimerWheel* wheel) {
+  for (int list = 0; list <= backlog(wheel); list++) {
+    for (int timer = wheel->heads[list]; timer >= 0;
+         timer = wheel->next[timer]) {
+      wheel->list[timer] = TIMER_IDLE;
+    }
+    wheel->heads[list] = -1;
+    wheel->tails[list] = -1;
+  }
+}
+
+void timer_wheel_schedule(TimerWheel* wheel, int timer, Uint64 due_tick,
+                          Uint32 tag) {
+  if (wheel->list[timer] != TIMER_IDLE)
+    unlink_timer(wheel, timer);
+  wheel->due_tick[timer] = due_tick;
+  wheel->tag[timer] = tag;
+  link_timer(wheel, (int)(due_tick & (Uint64)(wheel->bucket_count - 1)),
+             timer);
+}
+
+void timer_wheel_advance(TimerWheel* wheel, Uint64 tick) {
+  int bucket = (int)(tick & (Uint64)(wheel->bucket_count - 1));
+  int head = wheel->heads[bucket];
+  if (head < 0)
+    return;
+
+  // Splice the whole bucket onto the backlog in O(1), keeping its order,
+  // then relabel its timers so they can be unlinked from the backlog later.
+  int queue = backlog(wheel);
+  int tail = wheel->tails[queue];
+  wheel->prev[head] = tail;
+  if (tail >= 0) {
+    wheel->next[tail] = head;
+  } else {
+    wheel->heads[queue] = head;
+  }
+  wheel->tails[queue] = wheel->tails[bucket];
+  for (int timer = head; timer >= 0; timer = wheel->next[timer]) {
+    wheel->list[timer] = queue;
+  }
+  wheel->heads[bucket] = -1;
+  wheel->tails[bucket] = -1;
+}
+
+int timer_wheel_pop(TimerWheel* wheel) {
+  int timer = wheel->heads[backlog(wheel)];
+  if (timer >= 0)
+    unlink_timer(wheel, timer);
+  return timer;
+}
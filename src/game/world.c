@@ -9,12 +9,15 @@
 
 #include "game/world.h"
 
+#include <limits.h>
 #include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include "core/audio.h"
-#include "core/renderer.h"
+#include "core/tracer.h"
+#include "game/entity_kernels.h"
+#include "game/entity_pools.h"
 
 // Define PI if it's not available in the math library, for portability.
 #ifndef M_PI
@@ -22,79 +25,245 @@
 #endif
 
 // --- Private Function Prototypes ---
-static void update_player(Player* player, const InputState* input);
-static void update_projectiles(Projectile projectiles[]);
+static void layout_world(World* world, Arena* arena,
+                         const WorldConfig* config);
+static void chunk_lists_init(ChunkLists* lists, Arena* arena, int capacity);
+static int chunk_count(int count);
+static void save_previous_positions(World* world);
+static void update_player(World* world, const InputState* input);
+static bool spawn_projectile(ProjectilePool* projectiles, float x, float y,
+                             float angle, float speed, bool is_enemy,
+                             SDL_Color color);
+static void update_projectile_chunk(void* context, int begin, int end);
+static void update_projectiles(World* world);
+static Uint64 random_cooldown(World* world, int min_ms, int max_ms);
+static void schedule_enemy_timer(World* world, int enemy, EnemyTimer kind,
+                                 Uint64 due_tick);
 static void spawn_enemy(World* world);
-static void update_enemies(World* world, AudioContext* audio);
+static void spawn_enemies(World* world);
+static int compare_indices(const void* a, const void* b);
+static void take_due_enemy_timers(World* world, int* retargeting,
+                                  int* retarget_count, int* firing,
+                                  int* fire_count);
+static void integrate_enemy_chunk(void* context, int begin, int end);
+static void update_enemies(World* world);
 
 // --- Public API Implementations ---
 
-void world_init(World* world) {
-  // For the initial setup, a full reset is sufficient.
+void world_config_init(WorldConfig* config) {
+  config->max_projectiles = DEFAULT_MAX_PROJECTILES;
+  config->max_enemies = DEFAULT_MAX_ENEMIES;
+  config->collision_mode = COLLISION_MODE_GRID;
+  config->seed = 0;
+  config->tick_rate = DEFAULT_SIM_RATE;
+  config->enemy_spawn_rate = ENEMY_SPAWN_RATE;
+  config->ai_event_budget = ENEMY_AI_EVENT_BUDGET;
+}
+
+bool world_init(World* world, const WorldConfig* config) {
+  // Run the layout once against a measuring arena to learn its exact size,
+  // then allocate that in one block and lay everything out for real.
+  Arena measure = {0};
+  layout_world(world, &measure, config);
+  if (!arena_init(&world->arena, measure.used)) {
+    fprintf(stderr, "ERROR: Failed to allocate %zu bytes for the world.\n",
+            measure.used);
+    return false;
+  }
+  layout_world(world, &world->arena, config);
+
+  world->collision_mode = config->collision_mode;
+  world->seed = config->seed;
+  world->tick_rate = config->tick_rate;
+  world->tick_scale = (float)SIM_REFERENCE_RATE / (float)config->tick_rate;
+  world->enemy_spawn_rate = config->enemy_spawn_rate;
+  world->ai_event_budget = config->ai_event_budget;
+  world->thread_pool = NULL;
+  world->frame_arena = NULL;
+  rng_seed(&world->rng, config->seed);
   world_reset(world);
+  return true;
+}
+
+void world_destroy(World* world) {
+  arena_destroy(&world->arena);
 }
 
 void world_reset(World* world) {
-  // Use memset to efficiently zero out the entire world structure, deactivating
-  // all entities.
-  memset(world, 0, sizeof(World));
+  // Releasing the live entities is O(live) and keeps the arena untouched, so
+  // a reset costs the same whatever the pool capacities are.
+  projectile_pool_clear(&world->projectiles);
+  enemy_pool_clear(&world->enemies);
+  timer_wheel_clear(&world->enemy_timers);
+  game_events_clear(&world->events);
 
   // Set up the initial state for the player.
   world->player.x = LOGICAL_WIDTH / 2.0f;
   world->player.y = LOGICAL_HEIGHT / 2.0f;
+  world->player.prev_x = world->player.x;
+  world->player.prev_y = world->player.y;
   world->player.radius = PLAYER_RADIUS;
   world->player.lives = PLAYER_START_LIVES;
 
   // Reset score and difficulty modifiers.
   world->score = 0;
   world->enemy_speed_multiplier = ENEMY_SPEED_MULTIPLIER;
+  world->tick = 0;
 }
 
-void world_update(World* world, const InputState* input, AudioContext* audio) {
-  update_player(&world->player, input);
-  update_projectiles(world->projectiles);
-  spawn_enemy(world);
-  update_enemies(world, audio);
+void world_set_thread_pool(World* world, ThreadPool* pool) {
+  world->thread_pool = pool;
 }
 
-void world_fire_player_projectile(World* world, RendererContext* renderer,
-                                  int mouse_x, int mouse_y,
-                                  AudioContext* audio) {
-  // Find the first inactive projectile in the pool to reuse.
-  for (int i = 0; i < MAX_PROJECTILES; i++) {
-    if (!world->projectiles[i].active) {
-      Projectile* p = &world->projectiles[i];
-
-      float logical_x, logical_y;
-      renderer_window_to_logical(renderer, mouse_x, mouse_y, &logical_x,
-                                 &logical_y);
-
-      // Calculate the angle from the player to the logical mouse position.
-      float angle =
-          atan2f(logical_y - world->player.y, logical_x - world->player.x);
-      p->x = world->player.x;
-      p->y = world->player.y;
-      p->dx = cosf(angle) * PROJECTILE_SPEED;
-      p->dy = sinf(angle) * PROJECTILE_SPEED;
-      p->radius = PROJECTILE_RADIUS;
-      p->active = true;
-      p->is_enemy = false;
-      p->color = (SDL_Color){255, 255, 0, 255};  // Yellow for player shots.
-      audio_play_sound(audio, audio->laser_sound);
-      return;  // Exit after firing one projectile to prevent machine-gunning.
-    }
+void world_set_frame_arena(World* world, FrameArena* arena) {
+  world->frame_arena = arena;
+}
+
+size_t world_scratch_mark(const World* world) {
+  return world->frame_arena ? frame_arena_used(world->frame_arena) : 0;
+}
+
+void* world_scratch(World* world, size_t size, void* fallback) {
+  if (!world->frame_arena)
+    return fallback;
+  void* memory =
+      frame_arena_alloc(world->frame_arena, size, ARENA_DEFAULT_ALIGNMENT);
+  return memory ? memory : fallback;
+}
+
+void world_scratch_rewind(World* world, size_t mark) {
+  if (world->frame_arena)
+    frame_arena_rewind(world->frame_arena, mark);
+}
+
+void world_update(World* world, const InputState* input) {
+  // Everything below, including the collision pass that follows, happens at
+  // the new tick.
+  TRACE_BEGIN("world_update");
+  world->tick++;
+  save_previous_positions(world);
+  update_player(world, input);
+  TRACE_BEGIN("update_projectiles");
+  update_projectiles(world);
+  TRACE_END("update_projectiles");
+  spawn_enemies(world);
+  TRACE_BEGIN("update_enemies");
+  update_enemies(world);
+  TRACE_END("update_enemies");
+  TRACE_END("world_update");
+}
+
+void world_fire_player_projectile(World* world, int target_x, int target_y) {
+  // Calculate the angle from the player to the target.
+  float angle = atan2f((float)target_y - world->player.y,
+                       (float)target_x - world->player.x);
+  // Only one projectile is fired per call to prevent machine-gunning.
+  if (spawn_projectile(&world->projectiles, world->player.x, world->player.y,
+                       angle, PROJECTILE_SPEED * world->tick_scale, false,
+                       (SDL_Color){255, 255, 0, 255})) {  // Yellow for player.
+    game_events_push(&world->events, GAME_EVENT_PLAYER_SHOT, world->player.x,
+                     world->player.y);
   }
 }
 
 // --- Private Function Implementations ---
 
+/**
+ * @brief Carves every array the world needs out of an arena.
+ *
+ * Each pool lays out its hot arrays before its cold ones, and every array
+ * starts on its own cache line.
+ * @param world A pointer to the World whose arrays are assigned.
+ * @param arena The arena to allocate from; may be a measuring arena.
+ * @param config A constant pointer to the settings sizing the world.
+ */
+static void layout_world(World* world, Arena* arena,
+                         const WorldConfig* config) {
+  projectile_pool_init(&world->projectiles, arena, config->max_projectiles);
+  enemy_pool_init(&world->enemies, arena, config->max_enemies);
+  spatial_grid_init(&world->projectile_grid, arena, config->max_projectiles);
+  world->projectile_consumed =
+      arena_alloc(arena, sizeof(bool) * (size_t)config->max_projectiles,
+                  ARENA_DEFAULT_ALIGNMENT);
+  chunk_lists_init(&world->culled_projectiles, arena,
+                   config->max_projectiles);
+  // Cooldowns are drawn in whole ticks, so the longest one at this tick rate
+  // is the furthest ahead any AI timer can be scheduled.
+  timer_wheel_init(&world->enemy_timers, arena,
+                   config->max_enemies * ENEMY_TIMER_COUNT,
+                   MS_TO_TICKS(SDL_max(ENEMY_SHOOT_COOLDOWN_MAX,
+                                       ENEMY_RETARGET_COOLDOWN_MAX),
+                               config->tick_rate));
+  world->retargeting_enemies =
+      arena_alloc(arena, sizeof(int) * (size_t)config->max_enemies,
+                  ARENA_DEFAULT_ALIGNMENT);
+  world->firing_enemies =
+      arena_alloc(arena, sizeof(int) * (size_t)config->max_enemies,
+                  ARENA_DEFAULT_ALIGNMENT);
+  world->enemy_hits =
+      arena_alloc(arena, sizeof(int) * (size_t)config->max_enemies,
+                  ARENA_DEFAULT_ALIGNMENT);
+  // In one tick the player fires once, every enemy fires once and is
+  // destroyed once, every projectile hits the player at most once, and the
+  // game ends once, so a buffer cleared after each tick never fills up.
+  game_events_init(&world->events, arena,
+                   config->max_projectiles + 2 * config->max_enemies + 2);
+}
+
+/**
+ * @brief Carves the arrays of a ChunkLists out of an arena.
+ * @param lists A pointer to the ChunkLists to lay out.
+ * @param arena The arena to allocate from; may be a measuring arena.
+ * @param capacity The capacity of the pool the lists index.
+ */
+static void chunk_lists_init(ChunkLists* lists, Arena* arena, int capacity) {
+  lists->items = arena_alloc(arena, sizeof(int) * (size_t)capacity,
+                             ARENA_DEFAULT_ALIGNMENT);
+  lists->counts =
+      arena_alloc(arena, sizeof(int) * (size_t)chunk_count(capacity),
+                  ARENA_DEFAULT_ALIGNMENT);
+}
+
+/**
+ * @brief Returns how many parallel chunks cover a number of entities.
+ * @param count The number of entities.
+ * @return The number of chunks of PARALLEL_CHUNK_ENTITIES.
+ */
+static int chunk_count(int count) {
+  return (count + PARALLEL_CHUNK_ENTITIES - 1) / PARALLEL_CHUNK_ENTITIES;
+}
+
+/**
+ * @brief Records where every entity is before the tick moves it.
+ *
+ * The renderer draws each entity between its previous and current position,
+ * so frames that fall between two ticks still show smooth motion.
+ * @param world A pointer to the game world.
+ */
+static void save_previous_positions(World* world) {
+  Player* player = &world->player;
+  player->prev_x = player->x;
+  player->prev_y = player->y;
+
+  ProjectilePool* projectiles = &world->projectiles;
+  size_t bytes = sizeof(float) * (size_t)projectiles->slots.count;
+  memcpy(projectiles->prev_x, projectiles->x, bytes);
+  memcpy(projectiles->prev_y, projectiles->y, bytes);
+
+  EnemyPool* enemies = &world->enemies;
+  bytes = sizeof(float) * (size_t)enemies->slots.count;
+  memcpy(enemies->prev_x, enemies->x, bytes);
+  memcpy(enemies->prev_y, enemies->y, bytes);
+}
+
 /**
  * @brief Updates the player's position based on keyboard input and clamps it
  * to the screen bounds.
- * @param player A pointer to the player struct to be updated.
+ * @param world A pointer to the game world owning the player.
  * @param input A constant pointer to the current input state.
  */
-static void update_player(Player* player, const InputState* input) {
+static void update_player(World* world, const InputState* input) {
+  Player* player = &world->player;
   float dx = 0.0f, dy = 0.0f;
 
   // Aggregate input from both WASD and arrow keys.
@@ -115,8 +284,9 @@ static void update_player(Player* player, const InputState* input) {
   // Without this, diagonal movement would be faster than cardinal movement.
   float len = sqrtf(dx * dx + dy * dy);
   if (len > 0.0f) {
-    player->x += (dx / len) * PLAYER_SPEED;
-    player->y += (dy / len) * PLAYER_SPEED;
+    float speed = PLAYER_SPEED * world->tick_scale;
+    player->x += (dx / len) * speed;
+    player->y += (dy / len) * speed;
   }
 
   // Clamp player position to keep the ship within the logical screen bounds.
@@ -127,138 +297,320 @@ static void update_player(Player* player, const InputState* input) {
 }
 
 /**
- * @brief Updates the positions of all active projectiles and deactivates them
- * if they go off-screen.
- * @param projectiles An array containing the projectile pool.
+ * @brief Adds a projectile to the pool, moving at a given angle and speed.
+ * @param projectiles A pointer to the projectile pool.
+ * @param x The X coordinate of the spawn point.
+ * @param y The Y coordinate of the spawn point.
+ * @param angle The direction of travel, in radians.
+ * @param speed The distance traveled per tick.
+ * @param is_enemy True if the projectile was fired by an enemy.
+ * @param color The render color of the projectile.
+ * @return True if the projectile was spawned, false if the pool is full.
  */
-static void update_projectiles(Projectile projectiles[]) {
-  for (int i = 0; i < MAX_PROJECTILES; i++) {
-    if (projectiles[i].active) {
-      projectiles[i].x += projectiles[i].dx;
-      projectiles[i].y += projectiles[i].dy;
-
-      // Deactivate the projectile if it's far off-screen to free it up for
-      // reuse.
-      if (projectiles[i].x < -PROJECTILE_DESTROY_OFFSET ||
-          projectiles[i].x > LOGICAL_WIDTH + PROJECTILE_DESTROY_OFFSET ||
-          projectiles[i].y < -PROJECTILE_DESTROY_OFFSET ||
-          projectiles[i].y > LOGICAL_HEIGHT + PROJECTILE_DESTROY_OFFSET) {
-        projectiles[i].active = false;
-      }
+static bool spawn_projectile(ProjectilePool* projectiles, float x, float y,
+                             float angle, float speed, bool is_enemy,
+                             SDL_Color color) {
+  int i = projectile_pool_acquire(projectiles);
+  if (i < 0)
+    return false;
+  projectiles->x[i] = x;
+  projectiles->y[i] = y;
+  projectiles->prev_x[i] = x;
+  projectiles->prev_y[i] = y;
+  projectiles->dx[i] = cosf(angle) * speed;
+  projectiles->dy[i] = sinf(angle) * speed;
+  projectiles->is_enemy[i] = is_enemy;
+  projectiles->color[i] = color;
+  return true;
+}
+
+/**
+ * @brief Moves one chunk of projectiles and lists those that went
+ * off-screen.
+ *
+ * Both steps run as SIMD kernels over the chunk.
+ * @param context A pointer to the game world.
+ * @param begin The first projectile of the chunk.
+ * @param end One past the last projectile of the chunk.
+ */
+static void update_projectile_chunk(void* context, int begin, int end) {
+  World* world = context;
+  ProjectilePool* projectiles = &world->projectiles;
+  entity_kernels_integrate(projectiles->x + begin, projectiles->y + begin,
+                           projectiles->dx + begin, projectiles->dy + begin,
+                           end - begin);
+
+  int* culled = world->culled_projectiles.items + begin;
+  int culled_count = entity_kernels_cull(
+      projectiles->x + begin, projectiles->y + begin, end - begin,
+      -PROJECTILE_DESTROY_OFFSET, -PROJECTILE_DESTROY_OFFSET,
+      LOGICAL_WIDTH + PROJECTILE_DESTROY_OFFSET,
+      LOGICAL_HEIGHT + PROJECTILE_DESTROY_OFFSET, culled);
+  for (int k = 0; k < culled_count; k++) {
+    culled[k] += begin;
+  }
+  world->culled_projectiles.counts[begin / PARALLEL_CHUNK_ENTITIES] =
+      culled_count;
+}
+
+/**
+ * @brief Updates the positions of all live projectiles and removes them if
+ * they go off-screen.
+ * @param world A pointer to the game world.
+ */
+static void update_projectiles(World* world) {
+  ProjectilePool* projectiles = &world->projectiles;
+  int count = projectiles->slots.count;
+  thread_pool_parallel_for(world->thread_pool, count, PARALLEL_CHUNK_ENTITIES,
+                           update_projectile_chunk, world);
+
+  // Remove projectiles that are far off-screen to free them up for reuse.
+  // Releasing from the back (last chunk first) means every swapped-in
+  // projectile has already been checked.
+  const ChunkLists* culled = &world->culled_projectiles;
+  for (int c = chunk_count(count) - 1; c >= 0; c--) {
+    const int* items = culled->items + c * PARALLEL_CHUNK_ENTITIES;
+    for (int k = culled->counts[c] - 1; k >= 0; k--) {
+      projectile_pool_release(projectiles, items[k]);
     }
   }
 }
 
 /**
- * @brief Potentially spawns a new enemy at a random position just outside the
- * screen bounds.
+ * @brief Picks a random AI cooldown and converts it to simulation ticks.
+ * @param world A pointer to the game world, for its generator and tick rate.
+ * @param min_ms The shortest cooldown, in milliseconds.
+ * @param max_ms The exclusive upper bound of the cooldown, in milliseconds.
+ * @return The cooldown, in ticks.
+ */
+static Uint64 random_cooldown(World* world, int min_ms, int max_ms) {
+  int ms = min_ms + rng_range(&world->rng, max_ms - min_ms);
+  return (Uint64)MS_TO_TICKS(ms, world->tick_rate);
+}
+
+/**
+ * @brief Schedules one of an enemy's AI timers.
+ *
+ * The timer is tagged with the enemy's generation, so it is recognized as
+ * stale if the enemy is destroyed before it is due.
+ * @param world A pointer to the game world.
+ * @param enemy The dense index of the enemy.
+ * @param kind Which of the enemy's timers to schedule.
+ * @param due_tick The world tick the timer is due on.
+ */
+static void schedule_enemy_timer(World* world, int enemy, EnemyTimer kind,
+                                 Uint64 due_tick) {
+  EntityHandle handle = enemy_pool_handle(&world->enemies, enemy);
+  timer_wheel_schedule(&world->enemy_timers,
+                       (int)handle.slot * ENEMY_TIMER_COUNT + (int)kind,
+                       due_tick, handle.generation);
+}
+
+/**
+ * @brief Spawns a new enemy at a random position just outside the screen
+ * bounds.
  * @param world A pointer to the game world.
  */
 static void spawn_enemy(World* world) {
-  // Use a random chance to determine if an enemy should spawn this frame.
-  // This prevents enemies from spawning every single frame.
-  if ((float)rand() / RAND_MAX > ENEMY_SPAWN_RATE)
+  Rng* rng = &world->rng;
+
+  // Reserve a slot for the new enemy; spawning is skipped when full.
+  EnemyPool* pool = &world->enemies;
+  int i = enemy_pool_acquire(pool);
+  if (i < 0)
     return;
 
-  // Find an inactive enemy slot to use.
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (!world->enemies[i].active) {
-      Enemy* enemy = &world->enemies[i];
-      int side = rand() % 4;
-      // Determine spawn position based on a randomly chosen screen edge.
-      switch (side) {
-        case 0:  // Left
-          enemy->x = -ENEMY_SPAWN_OFFSET;
-          enemy->y = rand() % LOGICAL_HEIGHT;
-          break;
-        case 1:  // Right
-          enemy->x = LOGICAL_WIDTH + ENEMY_SPAWN_OFFSET;
-          enemy->y = rand() % LOGICAL_HEIGHT;
-          break;
-        case 2:  // Top
-          enemy->x = rand() % LOGICAL_WIDTH;
-          enemy->y = -ENEMY_SPAWN_OFFSET;
-          break;
-        case 3:  // Bottom
-          enemy->x = rand() % LOGICAL_WIDTH;
-          enemy->y = LOGICAL_HEIGHT + ENEMY_SPAWN_OFFSET;
-          break;
-      }
-
-      // Initial velocity is aimed at the player's current position.
-      float angle =
-          atan2f(world->player.y - enemy->y, world->player.x - enemy->x);
-      enemy->dx = cosf(angle) * world->enemy_speed_multiplier;
-      enemy->dy = sinf(angle) * world->enemy_speed_multiplier;
-      enemy->radius = ENEMY_RADIUS;
-      enemy->active = true;
-
-      // Set initial timers for AI behaviors (firing and retargeting).
-      Uint32 current_time = SDL_GetTicks();
-      enemy->next_fire_time =
-          current_time + ENEMY_SHOOT_COOLDOWN_MIN +
-          (rand() % (ENEMY_SHOOT_COOLDOWN_MAX - ENEMY_SHOOT_COOLDOWN_MIN));
-      enemy->next_retarget_time = current_time + ENEMY_RETARGET_COOLDOWN_MIN +
-                                  (rand() % (ENEMY_RETARGET_COOLDOWN_MAX -
-                                             ENEMY_RETARGET_COOLDOWN_MIN));
-      return;  // Exit after spawning one enemy per frame check.
+  float x = 0.0f, y = 0.0f;
+  int side = rng_range(rng, 4);
+  // Determine spawn position based on a randomly chosen screen edge.
+  switch (side) {
+    case 0:  // Left
+      x = -ENEMY_SPAWN_OFFSET;
+      y = rng_range(rng, LOGICAL_HEIGHT);
+      break;
+    case 1:  // Right
+      x = LOGICAL_WIDTH + ENEMY_SPAWN_OFFSET;
+      y = rng_range(rng, LOGICAL_HEIGHT);
+      break;
+    case 2:  // Top
+      x = rng_range(rng, LOGICAL_WIDTH);
+      y = -ENEMY_SPAWN_OFFSET;
+      break;
+    case 3:  // Bottom
+      x = rng_range(rng, LOGICAL_WIDTH);
+      y = LOGICAL_HEIGHT + ENEMY_SPAWN_OFFSET;
+      break;
+  }
+  pool->x[i] = x;
+  pool->y[i] = y;
+  pool->prev_x[i] = x;
+  pool->prev_y[i] = y;
+
+  // Initial velocity is aimed at the player's current position.
+  float angle = atan2f(world->player.y - y, world->player.x - x);
+  float speed = world->enemy_speed_multiplier * world->tick_scale;
+  pool->dx[i] = cosf(angle) * speed;
+  pool->dy[i] = sinf(angle) * speed;
+
+  // Set initial timers for AI behaviors (firing and retargeting).
+  schedule_enemy_timer(world, i, ENEMY_TIMER_FIRE,
+                       world->tick + random_cooldown(world,
+                                                     ENEMY_SHOOT_COOLDOWN_MIN,
+                                                     ENEMY_SHOOT_COOLDOWN_MAX));
+  schedule_enemy_timer(
+      world, i, ENEMY_TIMER_RETARGET,
+      world->tick + random_cooldown(world, ENEMY_RETARGET_COOLDOWN_MIN,
+                                    ENEMY_RETARGET_COOLDOWN_MAX));
+}
+
+/**
+ * @brief Spawns this tick's enemies.
+ *
+ * Whole spawns come first; the fractional part of the rate is the chance of
+ * one more, so rates below 1 spawn at most one enemy per tick.
+ * @param world A pointer to the game world.
+ */
+static void spawn_enemies(World* world) {
+  float expected = world->enemy_spawn_rate * world->tick_scale;
+  for (; expected >= 1.0f; expected -= 1.0f) {
+    spawn_enemy(world);
+  }
+  if (rng_float(&world->rng) <= expected)
+    spawn_enemy(world);
+}
+
+/**
+ * @brief Orders dense indices for qsort().
+ * @param a A pointer to the first index.
+ * @param b A pointer to the second index.
+ * @return A negative, zero or positive value as `a` sorts before, with or
+ * after `b`.
+ */
+static int compare_indices(const void* a, const void* b) {
+  int left = *(const int*)a;
+  int right = *(const int*)b;
+  return (left > right) - (left < right);
+}
+
+/**
+ * @brief Takes this tick's due AI timers out of the wheel.
+ *
+ * Timers are taken oldest first, up to the world's budget; the rest stay due
+ * for the next tick. Timers of destroyed enemies are dropped without counting
+ * against the budget. The enemies are listed in index order, so they act in
+ * the same order as if every enemy had checked its own timers.
+ * @param world A pointer to the game world.
+ * @param retargeting Receives the retargeting enemies; room for every live
+ * enemy.
+ * @param retarget_count A pointer that receives the number of retargeting
+ * enemies.
+ * @param firing Receives the firing enemies; room for every live enemy.
+ * @param fire_count A pointer that receives the number of firing enemies.
+ */
+static void take_due_enemy_timers(World* world, int* retargeting,
+                                  int* retarget_count, int* firing,
+                                  int* fire_count) {
+  TimerWheel* timers = &world->enemy_timers;
+  timer_wheel_advance(timers, world->tick);
+
+  int budget = world->ai_event_budget > 0 ? world->ai_event_budget : INT_MAX;
+  int retargets = 0, fires = 0;
+  int timer;
+  while (budget > 0 && (timer = timer_wheel_pop(timers)) >= 0) {
+    EntityHandle handle = {(Uint32)(timer / ENEMY_TIMER_COUNT),
+                           timers->tag[timer]};
+    int i = enemy_pool_resolve(&world->enemies, handle);
+    if (i < 0)
+      continue;
+    budget--;
+    if (timer % ENEMY_TIMER_COUNT == ENEMY_TIMER_FIRE) {
+      firing[fires++] = i;
+    } else {
+      retargeting[retargets++] = i;
     }
   }
+
+  qsort(retargeting, (size_t)retargets, sizeof(int), compare_indices);
+  qsort(firing, (size_t)fires, sizeof(int), compare_indices);
+  *retarget_count = retargets;
+  *fire_count = fires;
+}
+
+/**
+ * @brief Moves one chunk of enemies along their current velocities.
+ * @param context A pointer to the game world.
+ * @param begin The first enemy of the chunk.
+ * @param end One past the last enemy of the chunk.
+ */
+static void integrate_enemy_chunk(void* context, int begin, int end) {
+  EnemyPool* enemies = &((World*)context)->enemies;
+  entity_kernels_integrate(enemies->x + begin, enemies->y + begin,
+                           enemies->dx + begin, enemies->dy + begin,
+                           end - begin);
 }
 
 /**
  * @brief Updates enemy positions, handles their shooting logic, and re-targets
  * the player periodically.
+ *
+ * Only the enemies whose AI timers are due are visited. Retargeting happens
+ * before and firing after the move, which runs as a SIMD kernel over all
+ * live enemies and in parallel chunks when a thread pool is set.
  * @param world A pointer to the game world.
- * @param audio A pointer to the audio context for playing enemy firing sounds.
  */
-static void update_enemies(World* world, AudioContext* audio) {
-  Uint32 current_time = SDL_GetTicks();
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (world->enemies[i].active) {
-      Enemy* e = &world->enemies[i];
-
-      // AI Retargeting logic: Periodically update the enemy's trajectory to
-      // follow the player.
-      if (current_time > e->next_retarget_time) {
-        float angle = atan2f(world->player.y - e->y, world->player.x - e->x);
-        e->dx = cosf(angle) * world->enemy_speed_multiplier;
-        e->dy = sinf(angle) * world->enemy_speed_multiplier;
-        // Set the timer for the next retarget.
-        e->next_retarget_time = current_time + ENEMY_RETARGET_COOLDOWN_MIN +
-                                (rand() % (ENEMY_RETARGET_COOLDOWN_MAX -
-                                           ENEMY_RETARGET_COOLDOWN_MIN));
-      }
-
-      // Update position based on current velocity.
-      e->x += e->dx;
-      e->y += e->dy;
-
-      // AI Firing logic: Fire a projectile if the cooldown has elapsed.
-      if (current_time > e->next_fire_time) {
-        // Find an inactive projectile to fire.
-        for (int j = 0; j < MAX_PROJECTILES; j++) {
-          if (!world->projectiles[j].active) {
-            Projectile* p = &world->projectiles[j];
-            float angle =
-                atan2f(world->player.y - e->y, world->player.x - e->x);
-            p->x = e->x;
-            p->y = e->y;
-            p->dx = cosf(angle) * ENEMY_PROJECTILE_SPEED;
-            p->dy = sinf(angle) * ENEMY_PROJECTILE_SPEED;
-            p->radius = PROJECTILE_RADIUS;
-            p->active = true;
-            p->is_enemy = true;
-            p->color = (SDL_Color){255, 50, 50, 255};  // Red for enemy shots.
-            audio_play_sound(audio, audio->enemy_laser_sound);
-            break;  // Only fire one projectile per cooldown cycle.
-          }
-        }
-        // Reset the firing cooldown timer.
-        e->next_fire_time =
-            current_time + ENEMY_SHOOT_COOLDOWN_MIN +
-            (rand() % (ENEMY_SHOOT_COOLDOWN_MAX - ENEMY_SHOOT_COOLDOWN_MIN));
-      }
+static void update_enemies(World* world) {
+  EnemyPool* enemies = &world->enemies;
+  Uint64 tick = world->tick;
+  float speed = world->enemy_speed_multiplier * world->tick_scale;
+  float projectile_speed = ENEMY_PROJECTILE_SPEED * world->tick_scale;
+  // Each live enemy has one timer of each kind, so neither list outgrows
+  // the pool.
+  size_t scratch = world_scratch_mark(world);
+  size_t list_bytes = sizeof(int) * (size_t)enemies->slots.count;
+  int* retargeting =
+      world_scratch(world, list_bytes, world->retargeting_enemies);
+  int* firing = world_scratch(world, list_bytes, world->firing_enemies);
+  int retarget_count, fire_count;
+  take_due_enemy_timers(world, retargeting, &retarget_count, firing,
+                        &fire_count);
+
+  // AI Retargeting logic: Periodically update each enemy's trajectory to
+  // follow the player.
+  for (int k = 0; k < retarget_count; k++) {
+    int i = retargeting[k];
+    float angle = atan2f(world->player.y - enemies->y[i],
+                         world->player.x - enemies->x[i]);
+    enemies->dx[i] = cosf(angle) * speed;
+    enemies->dy[i] = sinf(angle) * speed;
+    // Set the timer for the next retarget.
+    schedule_enemy_timer(
+        world, i, ENEMY_TIMER_RETARGET,
+        tick + random_cooldown(world, ENEMY_RETARGET_COOLDOWN_MIN,
+                               ENEMY_RETARGET_COOLDOWN_MAX));
+  }
+
+  // Update positions based on current velocity, for all live enemies at once.
+  thread_pool_parallel_for(world->thread_pool, enemies->slots.count,
+                           PARALLEL_CHUNK_ENTITIES, integrate_enemy_chunk,
+                           world);
+
+  // AI Firing logic: Fire a projectile now that the cooldown has elapsed.
+  for (int k = 0; k < fire_count; k++) {
+    int i = firing[k];
+    float angle = atan2f(world->player.y - enemies->y[i],
+                         world->player.x - enemies->x[i]);
+    // Red for enemies.
+    if (spawn_projectile(&world->projectiles, enemies->x[i], enemies->y[i],
+                         angle, projectile_speed, true,
+                         (SDL_Color){255, 50, 50, 255})) {
+      game_events_push(&world->events, GAME_EVENT_ENEMY_SHOT, enemies->x[i],
+                       enemies->y[i]);
     }
+    // Reset the firing cooldown timer.
+    schedule_enemy_timer(world, i, ENEMY_TIMER_FIRE,
+                         tick + random_cooldown(world,
+                                                ENEMY_SHOOT_COOLDOWN_MIN,
+                                                ENEMY_SHOOT_COOLDOWN_MAX));
   }
+  world_scratch_rewind(world, scratch);
 }
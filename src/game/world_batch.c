@@ -0,0 +1,105 @@
+/**
+ * @file world_batch.c
+ * @brief Implements batches of bot-played worlds.
+ */
+
+#include "game/world_batch.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "core/tracer.h"
+#include "game/replay.h"
+
+// --- Private Helpers ---
+
+/**
+ * @brief Plays the game in one world until it ends.
+ * @param batch A pointer to the WorldBatch.
+ * @param entry A pointer to the world's entry.
+ */
+static void play_world(WorldBatch* batch, WorldBatchEntry* entry) {
+  World* world = &entry->world;
+  world_reset(world);
+  InputState input = {0};
+  input.keyboard_state = entry->keyboard;
+  bool game_over = false;
+
+  Uint64 tick = 0;
+  while (tick < batch->max_ticks && !game_over) {
+    TickInput tick_input;
+    bot_tick(batch->bot, world, tick, &tick_input);
+    tick_input_apply(&tick_input, entry->keyboard);
+    if (tick_input.fire) {
+      world_fire_player_projectile(world, tick_input.aim_x, tick_input.aim_y);
+    }
+    world_update(world, &input);
+    world_check_collisions(world);
+    game_over = game_events_count(&world->events, GAME_EVENT_GAME_OVER) > 0;
+    game_events_clear(&world->events);
+    tick++;
+  }
+
+  WorldBatchResult* result = &entry->result;
+  result->seed = world->seed;
+  result->score = world->score;
+  result->survival_ticks = tick;
+  result->survived = !game_over;
+}
+
+/**
+ * @brief Plays the games of a chunk of worlds.
+ * @param context A pointer to the WorldBatch.
+ * @param begin The first world of the chunk.
+ * @param end One past the last world of the chunk.
+ */
+static void play_worlds(void* context, int begin, int end) {
+  WorldBatch* batch = context;
+  TRACE_BEGIN("play_worlds");
+  for (int i = begin; i < end; i++) {
+    play_world(batch, &batch->entries[i]);
+  }
+  TRACE_END("play_worlds");
+}
+
+// --- Public API Implementations ---
+
+bool world_batch_init(WorldBatch* batch, const WorldConfig* config, int count,
+                      BotKind bot) {
+  memset(batch, 0, sizeof(*batch));
+  batch->entries = SDL_calloc((size_t)count, sizeof(WorldBatchEntry));
+  if (!batch->entries) {
+    fprintf(stderr, "ERROR: Failed to allocate a batch of %d worlds.\n",
+            count);
+    return false;
+  }
+  batch->bot = bot;
+
+  WorldConfig world_config = *config;
+  for (int i = 0; i < count; i++) {
+    world_config.seed = config->seed + (Uint64)i;
+    if (!world_init(&batch->entries[i].world, &world_config)) {
+      world_batch_destroy(batch);
+      return false;
+    }
+    // Count only the worlds that exist, so a failure destroys just those.
+    batch->count = i + 1;
+  }
+  return true;
+}
+
+void world_batch_run(WorldBatch* batch, ThreadPool* pool, Uint64 max_ticks) {
+  batch->max_ticks = max_ticks;
+  // One world per chunk: a game lasts thousands of ticks, so stealing single
+  // worlds costs nothing and evens out games of very different lengths.
+  thread_pool_parallel_for(pool, batch->count, 1, play_worlds, batch);
+}
+
+void world_batch_destroy(WorldBatch* batch) {
+  for (int i = 0; i < batch->count; i++) {
+    world_destroy(&batch->entries[i].world);
+  }
+  SDL_free(batch->entries);
+  batch->entries = NULL;
+  batch->count = 0;
+}
@@ -5,13 +5,42 @@
  * This file is dedicated to checking for overlaps between different types of
  * game entities and applying the appropriate game rules, such as losing lives
  * or gaining score.
+ *
+ * Projectile lookups go through a uniform-grid broadphase by default, so the
+ * narrowphase only runs on nearby pairs. The original brute-force scan is kept
+ * behind COLLISION_MODE_BRUTE_FORCE; both paths pick the lowest-indexed
+ * colliding projectile and therefore resolve every collision identically.
+ *
+ * Destroyed projectiles are only flagged during the checks and released
+ * afterwards, so the dense indices stored in the grid stay valid for the
+ * whole pass.
+ *
+ * The enemy checks run in two steps. Finding what each enemy touches is
+ * read-only and runs in parallel over the thread pool; applying the hits
+ * runs serially from the back of the enemy pool, so of several enemies
+ * overlapping one projectile the highest-indexed one gets it. The search is
+ * re-run for the rare enemy whose projectile was already taken.
  */
 
 #include <math.h>
+#include <string.h>
 
-#include "core/audio.h"
+#include "core/tracer.h"
+#include "game/entity_pools.h"
 #include "game/world.h"
 
+#define ENEMY_HIT_NONE -1    // The enemy touches nothing.
+#define ENEMY_HIT_PLAYER -2  // The enemy touches the player.
+
+/**
+ * @struct EnemyHitSearch
+ * @brief The parallel search for what each enemy touches.
+ */
+typedef struct {
+  const World* world;  ///< The world being checked.
+  int* hits;           ///< Receives one hit per live enemy.
+} EnemyHitSearch;
+
 // --- Private Helper ---
 
 /**
@@ -41,61 +70,227 @@ static bool check_circle_collision(float x1, float y1, int r1, float x2,
   return distance_squared < radii_sum_squared;
 }
 
-// --- Public API Implementation ---
+/**
+ * @brief Inserts every live projectile into the broadphase grid.
+ * @param world A pointer to the game world.
+ */
+static void build_projectile_grid(World* world) {
+  const ProjectilePool* pool = &world->projectiles;
+  spatial_grid_clear(&world->projectile_grid);
+  for (int i = 0; i < pool->slots.count; i++) {
+    spatial_grid_insert(&world->projectile_grid, i, pool->x[i], pool->y[i]);
+  }
+  spatial_grid_finalize(&world->projectile_grid);
+}
+
+/**
+ * @brief Reports whether a projectile can still hit an enemy this tick.
+ * @param world A constant pointer to the game world.
+ * @param j The dense index of the projectile.
+ * @return True if the projectile is a player shot not yet consumed.
+ */
+static bool is_live_player_projectile(const World* world, int j) {
+  return !world->projectiles.is_enemy[j] && !world->projectile_consumed[j];
+}
 
-void world_check_collisions(World* world, AudioContext* audio,
-                            GameStateEnum* current_state) {
-  // Iterate through all active enemies to check for collisions.
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (!world->enemies[i].active)
+/**
+ * @brief Finds the first player projectile hitting an enemy by scanning the
+ * whole projectile pool.
+ * @param world A constant pointer to the game world.
+ * @param enemy The dense index of the enemy being tested.
+ * @return The index of the lowest-indexed colliding projectile, or -1.
+ */
+static int find_projectile_hit_brute_force(const World* world, int enemy) {
+  const EnemyPool* enemies = &world->enemies;
+  const ProjectilePool* projectiles = &world->projectiles;
+  for (int j = 0; j < projectiles->slots.count; j++) {
+    // Only check projectiles that are not fired by enemies.
+    if (!is_live_player_projectile(world, j))
       continue;
-    Enemy* enemy = &world->enemies[i];
+    if (check_circle_collision(enemies->x[enemy], enemies->y[enemy],
+                               enemies->radius, projectiles->x[j],
+                               projectiles->y[j], projectiles->radius)) {
+      return j;
+    }
+  }
+  return -1;
+}
 
-    // --- 1. Enemy vs. Player Collision ---
-    if (check_circle_collision(enemy->x, enemy->y, enemy->radius,
+/**
+ * @brief Finds the first player projectile hitting an enemy using the
+ * broadphase grid.
+ *
+ * Candidates from several cells arrive out of index order, so the lowest
+ * colliding index is tracked explicitly to match the brute-force result.
+ * @param world A constant pointer to the game world.
+ * @param enemy The dense index of the enemy being tested.
+ * @return The index of the lowest-indexed colliding projectile, or -1.
+ */
+static int find_projectile_hit_grid(const World* world, int enemy) {
+  const EnemyPool* enemies = &world->enemies;
+  const ProjectilePool* projectiles = &world->projectiles;
+  float ex = enemies->x[enemy];
+  float ey = enemies->y[enemy];
+  SpatialGridRange range = spatial_grid_query(
+      ex, ey, (float)(enemies->radius + projectiles->radius));
+  int best = -1;
+  for (int row = range.row_min; row <= range.row_max; row++) {
+    for (int col = range.col_min; col <= range.col_max; col++) {
+      int count;
+      const int* items =
+          spatial_grid_cell_items(&world->projectile_grid, col, row, &count);
+      for (int k = 0; k < count; k++) {
+        int j = items[k];
+        if ((best >= 0 && j > best) || !is_live_player_projectile(world, j))
+          continue;
+        if (check_circle_collision(ex, ey, enemies->radius, projectiles->x[j],
+                                   projectiles->y[j], projectiles->radius)) {
+          best = j;
+        }
+      }
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Finds the first player projectile hitting an enemy with the
+ * configured algorithm.
+ * @param world A constant pointer to the game world.
+ * @param enemy The dense index of the enemy being tested.
+ * @return The index of the lowest-indexed colliding projectile, or -1.
+ */
+static int find_projectile_hit(const World* world, int enemy) {
+  return world->collision_mode == COLLISION_MODE_GRID
+             ? find_projectile_hit_grid(world, enemy)
+             : find_projectile_hit_brute_force(world, enemy);
+}
+
+/**
+ * @brief Records what each enemy of a chunk collides with.
+ *
+ * No projectile is consumed yet, so this only reads the world.
+ * @param context A pointer to the EnemyHitSearch.
+ * @param begin The first enemy of the chunk.
+ * @param end One past the last enemy of the chunk.
+ */
+static void find_enemy_hits(void* context, int begin, int end) {
+  const EnemyHitSearch* search = context;
+  const World* world = search->world;
+  const EnemyPool* enemies = &world->enemies;
+  for (int i = begin; i < end; i++) {
+    if (check_circle_collision(enemies->x[i], enemies->y[i], enemies->radius,
                                world->player.x, world->player.y,
                                world->player.radius)) {
+      search->hits[i] = ENEMY_HIT_PLAYER;
+    } else {
+      search->hits[i] = find_projectile_hit(world, i);
+    }
+  }
+}
+
+/**
+ * @brief Applies the effects of an enemy projectile hitting the player, if the
+ * two overlap.
+ * @param world A pointer to the game world.
+ * @param proj The dense index of the projectile to test.
+ */
+static void check_player_hit(World* world, int proj) {
+  const ProjectilePool* projectiles = &world->projectiles;
+  if (!projectiles->is_enemy[proj] || world->projectile_consumed[proj])
+    return;
+  if (check_circle_collision(projectiles->x[proj], projectiles->y[proj],
+                             projectiles->radius, world->player.x,
+                             world->player.y, world->player.radius)) {
+    world->player.lives--;
+    world->projectile_consumed[proj] = true;  // Destroy it on collision.
+    game_events_push(&world->events, GAME_EVENT_PLAYER_HIT, world->player.x,
+                     world->player.y);
+  }
+}
+
+// --- Public API Implementation ---
+
+void world_check_collisions(World* world) {
+  TRACE_BEGIN("world_check_collisions");
+  EnemyPool* enemies = &world->enemies;
+  ProjectilePool* projectiles = &world->projectiles;
+  bool use_grid = world->collision_mode == COLLISION_MODE_GRID;
+  memset(world->projectile_consumed, 0,
+         (size_t)projectiles->slots.count * sizeof(bool));
+  if (use_grid) {
+    build_projectile_grid(world);
+  }
+  size_t scratch = world_scratch_mark(world);
+  EnemyHitSearch search = {
+      world, world_scratch(world, sizeof(int) * (size_t)enemies->slots.count,
+                           world->enemy_hits)};
+  thread_pool_parallel_for(world->thread_pool, enemies->slots.count,
+                           PARALLEL_CHUNK_ENTITIES, find_enemy_hits, &search);
+
+  // Iterate through all live enemies to apply their collisions. Walking from
+  // the back lets a destroyed enemy be released immediately: the enemy
+  // swapped into its place has already been handled, and every enemy still
+  // ahead sits at the index its hit was recorded for.
+  for (int i = enemies->slots.count - 1; i >= 0; i--) {
+    int hit = search.hits[i];
+
+    // --- 1. Enemy vs. Player Collision ---
+    if (hit == ENEMY_HIT_PLAYER) {
       world->player.lives--;
-      enemy->active = false;  // Destroy the enemy on collision.
-      audio_play_sound(audio, audio->explosion_sound);
+      game_events_push(&world->events, GAME_EVENT_PLAYER_HIT, world->player.x,
+                       world->player.y);
+      enemy_pool_release(enemies, i);  // Destroy the enemy on collision.
       continue;  // Skip further checks for this now-destroyed enemy.
     }
 
     // --- 2. Enemy vs. Player Projectiles Collision ---
-    for (int j = 0; j < MAX_PROJECTILES; j++) {
-      // Only check active projectiles that are not fired by enemies.
-      if (!world->projectiles[j].active || world->projectiles[j].is_enemy)
-        continue;
-      Projectile* proj = &world->projectiles[j];
-
-      if (check_circle_collision(enemy->x, enemy->y, enemy->radius, proj->x,
-                                 proj->y, proj->radius)) {
-        enemy->active = false;
-        proj->active = false;
-        world->score += 10;
-        audio_play_sound(audio, audio->explosion_sound);
-        break;  // Stop checking projectiles for this destroyed enemy.
-      }
+    // A projectile overlapping several enemies goes to the first one handled;
+    // the others search again among the projectiles that are left.
+    if (hit >= 0 && world->projectile_consumed[hit])
+      hit = find_projectile_hit(world, i);
+    if (hit != ENEMY_HIT_NONE) {
+      game_events_push(&world->events, GAME_EVENT_ENEMY_KILLED, enemies->x[i],
+                       enemies->y[i]);
+      enemy_pool_release(enemies, i);
+      world->projectile_consumed[hit] = true;
+      world->score += 10;
     }
   }
+  world_scratch_rewind(world, scratch);
 
   // --- 3. Player vs. Enemy Projectiles Collision ---
-  for (int i = 0; i < MAX_PROJECTILES; i++) {
-    // Only check active projectiles that were fired by enemies.
-    if (!world->projectiles[i].active || !world->projectiles[i].is_enemy)
-      continue;
-    Projectile* proj = &world->projectiles[i];
-
-    if (check_circle_collision(proj->x, proj->y, proj->radius, world->player.x,
-                               world->player.y, world->player.radius)) {
-      world->player.lives--;
-      proj->active = false;  // Destroy the projectile on collision.
-      audio_play_sound(audio, audio->explosion_sound);
+  if (use_grid) {
+    SpatialGridRange range = spatial_grid_query(
+        world->player.x, world->player.y,
+        (float)(world->player.radius + projectiles->radius));
+    for (int row = range.row_min; row <= range.row_max; row++) {
+      for (int col = range.col_min; col <= range.col_max; col++) {
+        int count;
+        const int* items =
+            spatial_grid_cell_items(&world->projectile_grid, col, row, &count);
+        for (int k = 0; k < count; k++) {
+          check_player_hit(world, items[k]);
+        }
+      }
     }
+  } else {
+    for (int i = 0; i < projectiles->slots.count; i++) {
+      check_player_hit(world, i);
+    }
+  }
+
+  // Release every projectile destroyed above, from the back so swapped-in
+  // projectiles are never ones that still need releasing.
+  for (int j = projectiles->slots.count - 1; j >= 0; j--) {
+    if (world->projectile_consumed[j])
+      projectile_pool_release(projectiles, j);
   }
 
   // --- 4. Check for Game Over Condition ---
   if (world->player.lives <= 0) {
-    *current_state = GAME_STATE_GAME_OVER;
+    game_events_push(&world->events, GAME_EVENT_GAME_OVER, world->player.x,
+                     world->player.y);
   }
+  TRACE_END("world_check_collisions");
 }
@@ -9,17 +9,25 @@
  * @brief The main function, serving as the application's entry point.
  * @param argc The number of command-line arguments.
  * @param argv An array of command-line argument strings.
- * @return 0 on successful execution, 1 on initialization failure.
+ * @return 0 on successful execution, 1 on invalid options, initialization
+ * failure, or a frame caught allocating by --alloc-check.
  */
 int main(int argc, char* argv[]) {
-  // Mark arguments as unused to prevent compiler warnings.
-  (void)argc;
-  (void)argv;
+  GameConfig config;
+  config_init(&config);
+  if (!config_parse_args(&config, argc, argv)) {
+    config_print_usage(argv[0]);
+    return 1;
+  }
+  if (config.show_help) {
+    config_print_usage(argv[0]);
+    return 0;
+  }
 
   Game game;
 
   // Initialize all game systems.
-  if (!game_init(&game)) {
+  if (!game_init(&game, &config)) {
     // An error during initialization is fatal and the program should exit.
     return 1;
   }
@@ -28,7 +36,5 @@ int main(int argc, char* argv[]) {
   game_run(&game);
 
   // Clean up all allocated resources before exiting.
-  game_cleanup(&game);
-
-  return 0;
+  return game_cleanup(&game) ? 0 : 1;
 }
@@ -0,0 +1,200 @@
+/**
+ * @file pack_main.c
+ * @brief The entry point of the offline asset packer.
+ *
+ * The packer bakes loose asset files into one archive for the game to map at
+ * startup. Every file is stored under the path it was given as, which must
+ * be the path the game loads it from. What is stored depends on the file:
+ *
+ * - Images (.jpg, .png, .bmp) are decoded and converted to PACK_PIXEL_FORMAT,
+ *   the format SDL's renderers use natively for textures.
+ * - Sound effects (.wav) are decoded and converted to the device format the
+ *   game opens the mixer with, so they can be played without a copy.
+ * - Anything else, such as fonts and music, is stored unchanged.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <SDL2/SDL_image.h>
+
+#include "core/asset_pack.h"
+#include "utils/constants.h"
+
+#define PACK_PIXEL_FORMAT SDL_PIXELFORMAT_ARGB8888  // Texture format of images.
+#define PACK_AUDIO_FORMAT AUDIO_S16SYS  // Sample format of sound effects.
+#define PACK_AUDIO_CHANNELS 2           // Channels of sound effects.
+
+// --- Private Helpers ---
+
+/**
+ * @brief Checks whether a path ends with an extension, ignoring case.
+ * @param path The file path.
+ * @param extension The extension, including the dot.
+ * @return true if the path has the extension.
+ */
+static bool has_extension(const char* path, const char* extension) {
+  size_t length = strlen(path);
+  size_t extension_length = strlen(extension);
+  return length >= extension_length &&
+         SDL_strcasecmp(path + length - extension_length, extension) == 0;
+}
+
+/**
+ * @brief Decodes an image into pixels of PACK_PIXEL_FORMAT.
+ * @param path The image file.
+ * @param entry A pointer to the entry to describe the pixels in.
+ * @return The pixels, to be freed with SDL_free(), or NULL on failure.
+ */
+static void* pack_image(const char* path, AssetEntry* entry) {
+  SDL_Surface* loaded = IMG_Load(path);
+  if (!loaded) {
+    fprintf(stderr, "ERROR: Failed to load image %s: %s\n", path,
+            IMG_GetError());
+    return NULL;
+  }
+  SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, PACK_PIXEL_FORMAT, 0);
+  SDL_FreeSurface(loaded);
+  if (!surface) {
+    fprintf(stderr, "ERROR: Failed to convert image %s: %s\n", path,
+            SDL_GetError());
+    return NULL;
+  }
+  entry->type = ASSET_IMAGE;
+  entry->format = PACK_PIXEL_FORMAT;
+  entry->width = (Uint32)surface->w;
+  entry->height = (Uint32)surface->h;
+  entry->pitch = (Uint32)surface->pitch;
+  entry->size = (Uint64)surface->pitch * (Uint64)surface->h;
+  void* pixels = SDL_malloc((size_t)entry->size);
+  if (pixels)
+    memcpy(pixels, surface->pixels, (size_t)entry->size);
+  SDL_FreeSurface(surface);
+  return pixels;
+}
+
+/**
+ * @brief Decodes a WAV file into samples in the game's device format.
+ * @param path The sound file.
+ * @param entry A pointer to the entry to describe the samples in.
+ * @return The samples, to be freed with SDL_free(), or NULL on failure.
+ */
+static void* pack_sound(const char* path, AssetEntry* entry) {
+  SDL_AudioSpec spec;
+  Uint8* samples;
+  Uint32 length;
+  if (!SDL_LoadWAV(path, &spec, &samples, &length)) {
+    fprintf(stderr, "ERROR: Failed to load sound %s: %s\n", path,
+            SDL_GetError());
+    return NULL;
+  }
+  SDL_AudioCVT cvt;
+  if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq,
+                        PACK_AUDIO_FORMAT, PACK_AUDIO_CHANNELS,
+                        AUDIO_SAMPLE_RATE) < 0) {
+    fprintf(stderr, "ERROR: Cannot convert sound %s: %s\n", path,
+            SDL_GetError());
+    SDL_FreeWAV(samples);
+    return NULL;
+  }
+  // The conversion runs in place and may need a larger buffer than its
+  // input.
+  cvt.len = (int)length;
+  cvt.buf = SDL_malloc((size_t)length * (size_t)cvt.len_mult);
+  if (cvt.buf) {
+    memcpy(cvt.buf, samples, length);
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+      fprintf(stderr, "ERROR: Failed to convert sound %s: %s\n", path,
+              SDL_GetError());
+      SDL_free(cvt.buf);
+      cvt.buf = NULL;
+    }
+  }
+  SDL_FreeWAV(samples);
+  entry->type = ASSET_SOUND;
+  entry->format = PACK_AUDIO_FORMAT;
+  entry->width = AUDIO_SAMPLE_RATE;
+  entry->height = PACK_AUDIO_CHANNELS;
+  entry->size = (Uint64)(cvt.needed ? cvt.len_cvt : cvt.len);
+  return cvt.buf;
+}
+
+/**
+ * @brief Reads a file to store unchanged.
+ * @param path The file.
+ * @param entry A pointer to the entry to describe the bytes in.
+ * @return The bytes, to be freed with SDL_free(), or NULL on failure.
+ */
+static void* pack_blob(const char* path, AssetEntry* entry) {
+  size_t size;
+  void* data = SDL_LoadFile(path, &size);
+  if (!data) {
+    fprintf(stderr, "ERROR: Failed to read %s: %s\n", path, SDL_GetError());
+    return NULL;
+  }
+  entry->type = ASSET_BLOB;
+  entry->size = size;
+  return data;
+}
+
+/**
+ * @brief Prints the command-line usage of the packer.
+ * @param program The name the packer was started as.
+ */
+static void print_usage(const char* program) {
+  printf("Usage: %s ARCHIVE FILE...\n\n", program);
+  printf("Bakes each FILE into ARCHIVE under the path it is given as.\n");
+  printf("Images and .wav sounds are stored decoded; other files as-is.\n");
+}
+
+// --- Entry Point ---
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    print_usage(argv[0]);
+    return 1;
+  }
+  int count = argc - 2;
+  if (count > ASSET_PACK_MAX_ENTRIES) {
+    fprintf(stderr, "ERROR: An archive holds at most %d files.\n",
+            ASSET_PACK_MAX_ENTRIES);
+    return 1;
+  }
+
+  AssetEntry entries[ASSET_PACK_MAX_ENTRIES] = {0};
+  void* data[ASSET_PACK_MAX_ENTRIES] = {0};
+  bool ok = true;
+  for (int i = 0; i < count && ok; i++) {
+    const char* path = argv[i + 2];
+    AssetEntry* entry = &entries[i];
+    if (strlen(path) >= ASSET_NAME_LENGTH) {
+      fprintf(stderr, "ERROR: Asset names are limited to %d characters: %s\n",
+              ASSET_NAME_LENGTH - 1, path);
+      ok = false;
+      break;
+    }
+    SDL_strlcpy(entry->name, path, sizeof(entry->name));
+    if (has_extension(path, ".jpg") || has_extension(path, ".png") ||
+        has_extension(path, ".bmp")) {
+      data[i] = pack_image(path, entry);
+    } else if (has_extension(path, ".wav")) {
+      data[i] = pack_sound(path, entry);
+    } else {
+      data[i] = pack_blob(path, entry);
+    }
+    ok = data[i] != NULL;
+    if (ok) {
+      printf("%-40s %10llu bytes\n", path, (unsigned long long)entry->size);
+    }
+  }
+
+  if (ok)
+    ok = asset_pack_write(argv[1], entries, (const void* const*)data, count);
+  if (ok)
+    printf("Wrote %d assets to %s.\n", count, argv[1]);
+  for (int i = 0; i < count; i++) {
+    SDL_free(data[i]);
+  }
+  IMG_Quit();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,681 @@
+/**
+ * @file sim_main.c
+ * @brief The entry point of the headless simulation runner.
+ *
+ * The runner drives the game world without a window, audio device or frame
+ * limiter. It feeds a bot's input, or the input of a replay recorded in the
+ * game, to world_update() and world_check_collisions() as fast as possible,
+ * then reports the throughput, the cost of each phase, the peak entity
+ * counts and the gameplay events the world reported. The player is reset
+ * whenever the world reports a game over, so long runs keep exercising a live
+ * world.
+ *
+ * With --scaling, the same run is then repeated on 1, 2, 4, ... threads to
+ * show how the update scales with cores. Every repeat must end in exactly
+ * the same world state; the runner fails if one does not.
+ *
+ * With --worlds M, the runner instead plays one game in each of M worlds with
+ * consecutive seeds, spread over every core, and reports the score and
+ * survival time of each.
+ *
+ * With --alloc-check, every tick after a short warm-up must make no heap
+ * allocations through SDL; the runner fails if one does.
+ *
+ * With --mix-bench, it skips the world entirely and times the software sound
+ * effect mixer on growing numbers of voices, to show how many fit in one
+ * audio buffer.
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/alloc_tracker.h"
+#include "core/config.h"
+#include "core/frame_arena.h"
+#include "core/sfx_mixer.h"
+#include "core/thread_pool.h"
+#include "core/tracer.h"
+#include "game/bot.h"
+#include "game/hash_trace.h"
+#include "game/replay.h"
+#include "game/world.h"
+#include "game/world_batch.h"
+#include "utils/rng.h"
+
+#define SIM_DEFAULT_TICKS \
+  100000  // Ticks simulated when --ticks and --replay are omitted.
+#define SIM_DEFAULT_SEED 1        // Seed used when --seed is omitted.
+#define SIM_MAX_WORLDS 1000000   // Upper bound for --worlds.
+#define MIX_BENCH_SOUND_FRAMES \
+  88200  // Length of the benchmark's sound; outlasts every timed buffer.
+#define MIX_BENCH_BUFFERS 16  // Buffers timed per voice count.
+
+/**
+ * @enum SimPhase
+ * @brief The timed phases of a simulation tick.
+ */
+typedef enum {
+  SIM_PHASE_UPDATE,      ///< Scripted firing and world_update().
+  SIM_PHASE_COLLISIONS,  ///< world_check_collisions().
+  SIM_PHASE_COUNT        ///< Number of phases.
+} SimPhase;
+
+static const char* const PHASE_NAMES[SIM_PHASE_COUNT] = {"update",
+                                                         "collisions"};
+
+/**
+ * @struct SimStats
+ * @brief Timings and counters accumulated over a run.
+ */
+typedef struct {
+  Uint64 phase_total[SIM_PHASE_COUNT];  ///< Summed counter ticks per phase.
+  Uint64 phase_max[SIM_PHASE_COUNT];    ///< Slowest single tick per phase.
+  Uint64 wall_total;                    ///< Counter ticks for the whole run.
+  int peak_projectiles;                 ///< Most live projectiles at once.
+  int peak_enemies;                     ///< Most live enemies at once.
+  int game_overs;                       ///< Times the player lost every life.
+  int events[GAME_EVENT_TYPE_COUNT];    ///< Gameplay events, by type.
+  long long alloc_ticks;                ///< Ticks after warm-up that allocated.
+  AllocCounts allocs;                   ///< Allocations those ticks made.
+} SimStats;
+
+/**
+ * @struct SimOptions
+ * @brief The settings only the runner has, on top of the GameConfig.
+ */
+typedef struct {
+  long long ticks;           ///< Ticks to simulate; 0 picks the default.
+  bool scaling;              ///< True to repeat the run on more threads.
+  bool mix_bench;            ///< True to benchmark the software mixer.
+  int worlds;                ///< Worlds in a batch run; 0 for a single run.
+  BotKind bot;               ///< The bot providing input without a replay.
+  const char* results_path;  ///< Per-world CSV of a batch run, or NULL.
+} SimOptions;
+
+/**
+ * @struct SimFiles
+ * @brief The replay and hash files a run reads from or writes to.
+ */
+typedef struct {
+  Replay replay;        ///< Input to play back instead of the bot.
+  Replay recording;     ///< Where each tick's input is recorded.
+  HashTrace hashes;     ///< Where each tick's world hash is recorded.
+  HashTrace reference;  ///< Hashes each tick is verified against.
+} SimFiles;
+
+// --- Private Helpers ---
+
+/**
+ * @brief Records the time spent in one phase of a tick.
+ * @param stats A pointer to the run statistics.
+ * @param phase The phase that was measured.
+ * @param elapsed The phase duration, in performance counter ticks.
+ */
+static void record_phase(SimStats* stats, SimPhase phase, Uint64 elapsed) {
+  stats->phase_total[phase] += elapsed;
+  if (elapsed > stats->phase_max[phase])
+    stats->phase_max[phase] = elapsed;
+}
+
+/**
+ * @brief Parses the runner's own options and removes them from argv.
+ *
+ * Every other argument is left in place for config_parse_args(), so the
+ * runner accepts the same world settings as the game.
+ * @param argc A pointer to the argument count, updated on return.
+ * @param argv The argument strings, compacted in place.
+ * @param options A pointer to the SimOptions to update; options that are not
+ * given are left untouched.
+ * @return true if the runner's options were valid.
+ */
+static bool parse_sim_args(int* argc, char* argv[], SimOptions* options) {
+  int kept = 1;
+  for (int i = 1; i < *argc; i++) {
+    const char* arg = argv[i];
+    if (strcmp(arg, "--scaling") == 0) {
+      options->scaling = true;
+      continue;
+    }
+    if (strcmp(arg, "--mix-bench") == 0) {
+      options->mix_bench = true;
+      continue;
+    }
+    bool takes_value = strcmp(arg, "--ticks") == 0 ||
+                       strcmp(arg, "--worlds") == 0 ||
+                       strcmp(arg, "--bot") == 0 ||
+                       strcmp(arg, "--results") == 0;
+    if (!takes_value) {
+      argv[kept++] = argv[i];
+      continue;
+    }
+    if (i + 1 >= *argc) {
+      fprintf(stderr, "ERROR: Option '%s' expects a value.\n", arg);
+      return false;
+    }
+    const char* value = argv[++i];
+    char* end;
+    if (strcmp(arg, "--ticks") == 0) {
+      if ((options->ticks = strtoll(value, &end, 10)) < 1 || *end != '\0') {
+        fprintf(stderr, "ERROR: --ticks expects a positive number.\n");
+        return false;
+      }
+    } else if (strcmp(arg, "--worlds") == 0) {
+      long worlds = strtol(value, &end, 10);
+      if (worlds < 1 || worlds > SIM_MAX_WORLDS || *end != '\0') {
+        fprintf(stderr, "ERROR: --worlds expects a number from 1 to %d.\n",
+                SIM_MAX_WORLDS);
+        return false;
+      }
+      options->worlds = (int)worlds;
+    } else if (strcmp(arg, "--bot") == 0) {
+      if (!bot_parse_kind(value, &options->bot)) {
+        fprintf(stderr, "ERROR: --bot expects 'script' or 'evade'.\n");
+        return false;
+      }
+    } else {
+      options->results_path = value;
+    }
+  }
+  *argc = kept;
+  return true;
+}
+
+/**
+ * @brief Prints the runner's usage, followed by the shared world options.
+ * @param program The program name to show in the usage line.
+ */
+static void print_usage(const char* program) {
+  config_print_usage(program);
+  printf("  %-30s %s\n", "--ticks N",
+         "Ticks to simulate (default 100000, or the whole replay).");
+  printf("  %-30s %s\n", "--scaling",
+         "Repeat the run on 1, 2, 4, ... threads and compare.");
+  printf("  %-30s %s\n", "--bot script|evade",
+         "Bot that plays when there is no replay (default script).");
+  printf("  %-30s %s\n", "--worlds M",
+         "Play one game in each of M worlds, on every core.");
+  printf("  %-30s %s\n", "--results FILE",
+         "Write the score and survival of each world as CSV.");
+  printf("  %-30s %s\n", "--mix-bench",
+         "Time the software sound mixer instead of the world.");
+}
+
+/**
+ * @brief Simulates a world for a number of ticks, collecting statistics.
+ * @param world A pointer to the initialized world to simulate; its frame
+ * arena, which must be set, is started anew every tick.
+ * @param ticks The number of ticks to simulate.
+ * @param bot The bot providing input when no replay is open.
+ * @param files A pointer to the run's files; the ones left closed are
+ * skipped. An open replay replaces the bot and ends the run early when it
+ * runs out.
+ * @param stats A pointer to the statistics to fill.
+ * @return The number of ticks actually simulated.
+ */
+static long long simulate(World* world, long long ticks, BotKind bot,
+                          SimFiles* files, SimStats* stats) {
+  static Uint8 keyboard[SDL_NUM_SCANCODES];
+  InputState input = {0};
+  input.keyboard_state = keyboard;
+
+  Uint64 run_start = SDL_GetPerformanceCounter();
+  long long tick = 0;
+  for (; tick < ticks; tick++) {
+    AllocCounts tick_allocs = alloc_tracker_totals();
+    frame_arena_begin(world->frame_arena);
+    TickInput tick_input;
+    if (files->replay.file) {
+      if (!replay_read_tick(&files->replay, &tick_input))
+        break;
+    } else {
+      bot_tick(bot, world, (Uint64)tick, &tick_input);
+    }
+    if (files->recording.file)
+      replay_write_tick(&files->recording, &tick_input);
+    tick_input_apply(&tick_input, keyboard);
+
+    TRACE_BEGIN("tick");
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (tick_input.fire) {
+      world_fire_player_projectile(world, tick_input.aim_x, tick_input.aim_y);
+    }
+    world_update(world, &input);
+    Uint64 mid = SDL_GetPerformanceCounter();
+    world_check_collisions(world);
+    Uint64 end = SDL_GetPerformanceCounter();
+    record_phase(stats, SIM_PHASE_UPDATE, mid - start);
+    record_phase(stats, SIM_PHASE_COLLISIONS, end - mid);
+    if (files->hashes.file || files->reference.file) {
+      Uint64 hash = world_hash(world);
+      if (files->hashes.file)
+        hash_trace_write(&files->hashes, hash);
+      if (files->reference.file)
+        hash_trace_verify(&files->reference, hash, world->tick);
+    }
+
+    if (world->projectiles.slots.count > stats->peak_projectiles)
+      stats->peak_projectiles = world->projectiles.slots.count;
+    if (world->enemies.slots.count > stats->peak_enemies)
+      stats->peak_enemies = world->enemies.slots.count;
+    bool game_over = false;
+    for (int i = 0; i < world->events.count; i++) {
+      GameEventType type = world->events.events[i].type;
+      stats->events[type]++;
+      game_over = game_over || type == GAME_EVENT_GAME_OVER;
+    }
+    game_events_clear(&world->events);
+    if (game_over) {
+      stats->game_overs++;
+      world_reset(world);
+    }
+    TRACE_END("tick");
+
+    AllocCounts allocs = alloc_tracker_since(tick_allocs);
+    if (allocs.count > 0 && tick >= ALLOC_CHECK_WARMUP) {
+      stats->alloc_ticks++;
+      stats->allocs.count += allocs.count;
+      stats->allocs.bytes += allocs.bytes;
+    }
+  }
+  stats->wall_total = SDL_GetPerformanceCounter() - run_start;
+  return tick;
+}
+
+/**
+ * @brief Prints the results of a run.
+ * @param config A constant pointer to the world settings used.
+ * @param stats A constant pointer to the run statistics.
+ * @param world A constant pointer to the world after the run.
+ * @param ticks The number of ticks simulated.
+ * @param threads The number of threads the run used.
+ */
+static void print_report(const WorldConfig* config, const SimStats* stats,
+                         const World* world, long long ticks, int threads) {
+  double ns_per_count = 1e9 / (double)SDL_GetPerformanceFrequency();
+  double seconds = (double)stats->wall_total * ns_per_count / 1e9;
+
+  printf("Simulated %lld ticks (%s collisions, seed %llu, %d threads)\n",
+         ticks,
+         config->collision_mode == COLLISION_MODE_GRID ? "grid" : "brute",
+         (unsigned long long)config->seed, threads);
+  printf("  %-18s %.1f s at %d Hz\n", "Game time:",
+         (double)ticks / (double)config->tick_rate, config->tick_rate);
+  printf("  %-18s %.3f s\n", "Wall time:", seconds);
+  printf("  %-18s %.0f ticks/s\n", "Throughput:",
+         seconds > 0.0 ? (double)ticks / seconds : 0.0);
+  printf("  %-18s %14s %14s\n", "Phase", "avg ns/tick", "max ns/tick");
+  for (int p = 0; p < SIM_PHASE_COUNT; p++) {
+    printf("  %-18s %14.0f %14.0f\n", PHASE_NAMES[p],
+           (double)stats->phase_total[p] * ns_per_count /
+               (double)SDL_max(ticks, 1),
+           (double)stats->phase_max[p] * ns_per_count);
+  }
+  printf("  %-18s %d / %d (%d dropped)\n", "Peak projectiles:",
+         stats->peak_projectiles, world->projectiles.slots.capacity,
+         world->projectiles.slots.dropped);
+  printf("  %-18s %d / %d (%d dropped)\n", "Peak enemies:",
+         stats->peak_enemies, world->enemies.slots.capacity,
+         world->enemies.slots.dropped);
+  printf("  %-18s %d\n", "Game overs:", stats->game_overs);
+  if (alloc_tracker_installed()) {
+    printf("  %-18s %lld ticks after warm-up, %u allocations (%u bytes)\n",
+           "Allocating ticks:", stats->alloc_ticks,
+           (unsigned)stats->allocs.count, (unsigned)stats->allocs.bytes);
+  }
+  printf("  %-18s %d player shots, %d enemy shots, %d kills, %d hits "
+         "(%d dropped)\n",
+         "Events:", stats->events[GAME_EVENT_PLAYER_SHOT],
+         stats->events[GAME_EVENT_ENEMY_SHOT],
+         stats->events[GAME_EVENT_ENEMY_KILLED],
+         stats->events[GAME_EVENT_PLAYER_HIT], world->events.dropped);
+  // Same seed and options must always print the same final state.
+  printf("  %-18s tick %llu, score %d, %d projectiles, %d enemies\n",
+         "Final state:", (unsigned long long)world->tick, world->score,
+         world->projectiles.slots.count, world->enemies.slots.count);
+}
+
+/**
+ * @brief Repeats a run on 1, 2, 4, ... threads and prints how it scales.
+ *
+ * Each repeat starts from a fresh world and, for a replay, reopens the file,
+ * so all of them simulate exactly the same ticks as the main run.
+ * @param config A constant pointer to the settings of the main run.
+ * @param ticks The number of ticks the main run simulated.
+ * @param bot The bot of the main run.
+ * @param max_threads The largest thread count to try.
+ * @param expected_hash The world hash at the end of the main run.
+ * @return true if every repeat ended in the expected state.
+ */
+static bool run_scaling(const GameConfig* config, long long ticks,
+                        BotKind bot, int max_threads, Uint64 expected_hash) {
+  printf("\nScaling over %lld ticks:\n", ticks);
+  printf("  %-8s %12s %12s %9s\n", "Threads", "Wall s", "Ticks/s",
+         "Speedup");
+  double frequency = (double)SDL_GetPerformanceFrequency();
+  double baseline = 0.0;
+  bool matched = true;
+  for (int threads = 1;; threads = SDL_min(threads * 2, max_threads)) {
+    WorldConfig world_config = config->world;
+    SimFiles files = {0};
+    if (config->replay_path[0] != '\0' &&
+        !replay_open(&files.replay, config->replay_path, &world_config))
+      return false;
+    World world;
+    ThreadPool pool;
+    FrameArena frame_arena;
+    if (!world_init(&world, &world_config)) {
+      replay_close(&files.replay);
+      return false;
+    }
+    if (!thread_pool_init(&pool, threads)) {
+      world_destroy(&world);
+      replay_close(&files.replay);
+      return false;
+    }
+    if (!frame_arena_init(&frame_arena, FRAME_ARENA_BYTES)) {
+      thread_pool_destroy(&pool);
+      world_destroy(&world);
+      replay_close(&files.replay);
+      return false;
+    }
+    world_set_thread_pool(&world, &pool);
+    world_set_frame_arena(&world, &frame_arena);
+
+    SimStats stats = {0};
+    simulate(&world, ticks, bot, &files, &stats);
+    double seconds = (double)stats.wall_total / frequency;
+    double rate = seconds > 0.0 ? (double)ticks / seconds : 0.0;
+    if (threads == 1)
+      baseline = rate;
+    bool same = world_hash(&world) == expected_hash;
+    printf("  %-8d %12.3f %12.0f %8.2fx%s\n", pool.thread_count, seconds,
+           rate, baseline > 0.0 ? rate / baseline : 0.0,
+           same ? "" : "  (state differs!)");
+    matched = matched && same;
+
+    frame_arena_destroy(&frame_arena);
+    thread_pool_destroy(&pool);
+    world_destroy(&world);
+    replay_close(&files.replay);
+    if (threads >= max_threads)
+      break;
+  }
+  if (!matched)
+    fprintf(stderr, "ERROR: Thread counts disagree on the final state.\n");
+  return matched;
+}
+
+/**
+ * @brief Writes the result of every world of a batch as CSV.
+ * @param path The file to create.
+ * @param batch A constant pointer to the batch that was run.
+ * @return true if the whole file was written.
+ */
+static bool write_batch_results(const char* path, const WorldBatch* batch) {
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "ERROR: Failed to create results file %s.\n", path);
+    return false;
+  }
+  fprintf(file, "world,seed,score,survival_ticks,survived\n");
+  for (int i = 0; i < batch->count; i++) {
+    const WorldBatchResult* result = &batch->entries[i].result;
+    fprintf(file, "%d,%llu,%d,%llu,%d\n", i,
+            (unsigned long long)result->seed, result->score,
+            (unsigned long long)result->survival_ticks, result->survived);
+  }
+  bool ok = !ferror(file);
+  if (fclose(file) != 0 || !ok) {
+    fprintf(stderr, "ERROR: Failed to write results file %s.\n", path);
+    return false;
+  }
+  printf("Per-world results written to %s.\n", path);
+  return true;
+}
+
+/**
+ * @brief Plays one game in each world of a batch and prints the totals.
+ * @param config A constant pointer to the settings every world starts from.
+ * @param options A constant pointer to the runner's options.
+ * @param ticks The tick limit of each game.
+ * @return true on success, false if the worlds, the threads or the results
+ * file could not be created.
+ */
+static bool run_batch(const GameConfig* config, const SimOptions* options,
+                      long long ticks) {
+  WorldBatch batch;
+  ThreadPool pool;
+  if (!world_batch_init(&batch, &config->world, options->worlds,
+                        options->bot))
+    return false;
+  if (!thread_pool_init(&pool, config->threads)) {
+    world_batch_destroy(&batch);
+    return false;
+  }
+
+  Uint64 start = SDL_GetPerformanceCounter();
+  world_batch_run(&batch, &pool, (Uint64)ticks);
+  double seconds = (double)(SDL_GetPerformanceCounter() - start) /
+                   (double)SDL_GetPerformanceFrequency();
+
+  const WorldBatchResult* first = &batch.entries[0].result;
+  int min_score = first->score, max_score = first->score;
+  Uint64 min_ticks = first->survival_ticks, max_ticks = first->survival_ticks;
+  double total_score = 0.0;
+  Uint64 total_ticks = 0;
+  int survivors = 0;
+  for (int i = 0; i < batch.count; i++) {
+    const WorldBatchResult* result = &batch.entries[i].result;
+    min_score = SDL_min(min_score, result->score);
+    max_score = SDL_max(max_score, result->score);
+    min_ticks = SDL_min(min_ticks, result->survival_ticks);
+    max_ticks = SDL_max(max_ticks, result->survival_ticks);
+    total_score += result->score;
+    total_ticks += result->survival_ticks;
+    survivors += result->survived;
+  }
+
+  printf("Played %d worlds (%s bot, seeds %llu-%llu, %d threads)\n",
+         batch.count, bot_kind_name(options->bot),
+         (unsigned long long)config->world.seed,
+         (unsigned long long)(config->world.seed + (Uint64)batch.count - 1),
+         pool.thread_count);
+  printf("  %-18s %.3f s\n", "Wall time:", seconds);
+  printf("  %-18s %llu\n", "World ticks:", (unsigned long long)total_ticks);
+  printf("  %-18s %.0f world-ticks/s\n", "Throughput:",
+         seconds > 0.0 ? (double)total_ticks / seconds : 0.0);
+  printf("  %-18s %d / %d (limit %lld ticks)\n", "Survived:", survivors,
+         batch.count, ticks);
+  printf("  %-18s %d min, %.1f avg, %d max\n", "Score:", min_score,
+         total_score / batch.count, max_score);
+  printf("  %-18s %llu min, %.1f avg, %llu max\n", "Survival ticks:",
+         (unsigned long long)min_ticks, (double)total_ticks / batch.count,
+         (unsigned long long)max_ticks);
+
+  bool ok = !options->results_path ||
+            write_batch_results(options->results_path, &batch);
+  thread_pool_destroy(&pool);
+  world_batch_destroy(&batch);
+  return ok;
+}
+
+/**
+ * @brief Times the software mixer on 16, 32, ... voices and prints how many
+ * voices one audio buffer can hold.
+ *
+ * Every voice plays the same noise burst, long enough to last through every
+ * timed buffer, so each count mixes exactly that many voices per buffer.
+ * @return true on success, false if the buffers could not be allocated.
+ */
+static bool run_mix_bench(void) {
+  Sint16* sound = malloc(sizeof(Sint16) * 2 * MIX_BENCH_SOUND_FRAMES);
+  Sint16* stream = malloc(sizeof(Sint16) * 2 * AUDIO_BUFFER_FRAMES);
+  SfxMixer* mixer = malloc(sizeof(SfxMixer));
+  if (!sound || !stream || !mixer) {
+    fprintf(stderr, "ERROR: Failed to allocate the mixer benchmark.\n");
+    free(sound);
+    free(stream);
+    free(mixer);
+    return false;
+  }
+  Rng rng;
+  rng_seed(&rng, SIM_DEFAULT_SEED);
+  for (int i = 0; i < 2 * MIX_BENCH_SOUND_FRAMES; i++) {
+    sound[i] = (Sint16)(rng_range(&rng, 16384) - 8192);
+  }
+
+  double frequency = (double)SDL_GetPerformanceFrequency();
+  double buffer_ms = 1000.0 * AUDIO_BUFFER_FRAMES / AUDIO_SAMPLE_RATE;
+  printf("Mixing %d-frame buffers (%.1f ms of audio, %s kernels)\n",
+         AUDIO_BUFFER_FRAMES, buffer_ms, sfx_mixer_kernel_name());
+  printf("  %-8s %12s %12s\n", "Voices", "us/buffer", "% of buffer");
+  double ms_per_voice = 0.0;
+  for (int voices = 16; voices <= SFX_MAX_VOICES; voices *= 2) {
+    sfx_mixer_init(mixer);
+    sfx_mixer_set_sound(mixer, 0, sound, MIX_BENCH_SOUND_FRAMES);
+    for (int v = 0; v < voices; v++) {
+      sfx_mixer_play(mixer, 0, 0.5f);
+    }
+    Uint64 total = 0;
+    for (int b = 0; b < MIX_BENCH_BUFFERS; b++) {
+      memset(stream, 0, sizeof(Sint16) * 2 * AUDIO_BUFFER_FRAMES);
+      Uint64 start = SDL_GetPerformanceCounter();
+      sfx_mixer_mix(mixer, stream, AUDIO_BUFFER_FRAMES);
+      total += SDL_GetPerformanceCounter() - start;
+    }
+    double ms = 1000.0 * (double)total / frequency / MIX_BENCH_BUFFERS;
+    printf("  %-8d %12.1f %11.2f%%\n", voices, ms * 1000.0,
+           100.0 * ms / buffer_ms);
+    // The largest count amortizes the fixed cost best.
+    ms_per_voice = ms / voices;
+  }
+  printf("  %-18s ~%.0f voices per buffer on one core\n", "Capacity:",
+         ms_per_voice > 0.0 ? buffer_ms / ms_per_voice : 0.0);
+
+  free(sound);
+  free(stream);
+  free(mixer);
+  return true;
+}
+
+// --- Entry Point ---
+
+/**
+ * @brief Runs the headless simulation and prints its report.
+ * @param argc The number of command-line arguments.
+ * @param argv An array of command-line argument strings.
+ * @return 0 on success, 1 on invalid options, initialization failure, a
+ * run that does not match its reference hashes, or a tick caught allocating
+ * by --alloc-check.
+ */
+int main(int argc, char* argv[]) {
+  SimOptions options = {0};
+  GameConfig config;
+  config_init(&config);
+  if (!parse_sim_args(&argc, argv, &options)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+  // A batch spreads its worlds over every core unless --threads says
+  // otherwise.
+  if (options.worlds > 0)
+    config.threads = 0;
+  if (!config_parse_args(&config, argc, argv)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+  if (config.show_help) {
+    print_usage(argv[0]);
+    return 0;
+  }
+  if (config.alloc_check && !alloc_tracker_install())
+    return 1;
+  if (options.mix_bench)
+    return run_mix_bench() ? 0 : 1;
+  // Benchmarks must be repeatable, so the runner never picks a random seed.
+  if (config.random_seed)
+    config.world.seed = SIM_DEFAULT_SEED;
+
+  if (options.worlds > 0) {
+    if (config.replay_path[0] != '\0' || config.record_path[0] != '\0' ||
+        config.record_hashes_path[0] != '\0' ||
+        config.verify_hashes_path[0] != '\0' || options.scaling ||
+        config.alloc_check) {
+      fprintf(stderr,
+              "ERROR: --worlds cannot be combined with replays, hash files, "
+              "--scaling or --alloc-check.\n");
+      return 1;
+    }
+    if (config.trace_path[0] != '\0' && !tracer_init(config.trace_path))
+      return 1;
+    bool ok = run_batch(&config, &options,
+                        options.ticks > 0 ? options.ticks : SIM_DEFAULT_TICKS);
+    tracer_shutdown();
+    return ok ? 0 : 1;
+  }
+  if (options.results_path) {
+    fprintf(stderr, "ERROR: --results needs --worlds.\n");
+    return 1;
+  }
+
+  if (config.trace_path[0] != '\0' && !tracer_init(config.trace_path))
+    return 1;
+  SimFiles files = {0};
+  if (config.replay_path[0] != '\0' &&
+      !replay_open(&files.replay, config.replay_path, &config.world))
+    return 1;
+  if (config.record_path[0] != '\0' &&
+      !replay_create(&files.recording, config.record_path, &config.world))
+    return 1;
+  if (config.record_hashes_path[0] != '\0' &&
+      !hash_trace_create(&files.hashes, config.record_hashes_path,
+                         config.world.seed))
+    return 1;
+  if (config.verify_hashes_path[0] != '\0' &&
+      !hash_trace_open(&files.reference, config.verify_hashes_path,
+                       config.world.seed))
+    return 1;
+  // A replay runs to its end unless --ticks cuts it short.
+  long long ticks = options.ticks;
+  if (ticks == 0)
+    ticks = files.replay.file ? LLONG_MAX : SIM_DEFAULT_TICKS;
+
+  World world;
+  ThreadPool pool;
+  FrameArena frame_arena;
+  if (!world_init(&world, &config.world) ||
+      !thread_pool_init(&pool, config.threads) ||
+      !frame_arena_init(&frame_arena, FRAME_ARENA_BYTES))
+    return 1;
+  world_set_thread_pool(&world, &pool);
+  world_set_frame_arena(&world, &frame_arena);
+
+  SimStats stats = {0};
+  long long simulated = simulate(&world, ticks, options.bot, &files, &stats);
+
+  print_report(&config.world, &stats, &world, simulated, pool.thread_count);
+  replay_close(&files.replay);
+  replay_close(&files.recording);
+  bool hashes_ok = hash_trace_close(&files.hashes);
+  bool verified = hash_trace_close(&files.reference);
+  Uint64 final_hash = world_hash(&world);
+  int max_threads = pool.thread_count > 1 ? pool.thread_count
+                                          : SDL_GetCPUCount();
+  frame_arena_destroy(&frame_arena);
+  thread_pool_destroy(&pool);
+  tracer_shutdown();
+  world_destroy(&world);
+
+  bool scaled = !options.scaling ||
+                run_scaling(&config, simulated, options.bot,
+                            SDL_clamp(max_threads, 1, THREAD_POOL_MAX_THREADS),
+                            final_hash);
+  bool allocation_free = stats.alloc_ticks == 0;
+  if (!allocation_free) {
+    fprintf(stderr, "ERROR: %lld ticks allocated after warm-up.\n",
+            stats.alloc_ticks);
+  }
+  return hashes_ok && verified && scaled && allocation_free ? 0 : 1;
+}